@@ -38,6 +38,7 @@
  * Includes
  *****************************************************************************/
 
+#include <stddef.h>
 #include <stdint.h>
 
 /******************************************************************************
@@ -50,16 +51,25 @@
 /** DLC Field Length in Bytes */
 #define DLC_LEN (1U)
 
-/** Checksum Field Length in Bytes */
+/** Checksum Field Length in Bytes of the default integrity policy */
 #define CHECKSUM_LEN (1U)
 
-/** Length of Complete Header Field */
+/** Length of Complete Header Field with the default integrity policy */
 #define HEADER_LEN (CHANNEL_LEN + DLC_LEN + CHECKSUM_LEN)
 
-/** Data Field Length in Bytes */
+/** Index of the Channel Field in a Frame */
+#define CHANNEL_FIELD_IDX (0U)
+
+/** Index of the DLC Field in a Frame */
+#define DLC_FIELD_IDX (CHANNEL_LEN)
+
+/** Index of the Checksum Field in a Frame */
+#define CHECKSUM_FIELD_IDX (CHANNEL_LEN + DLC_LEN)
+
+/** Default maximum Data Field Length in Bytes. See the tMaxDataLen parameter of the server. */
 #define MAX_DATA_LEN (32U)
 
-/** Total Frame Length in Bytes */
+/** Total Frame Length in Bytes with the default integrity policy */
 #define MAX_FRAME_LEN (HEADER_LEN + MAX_DATA_LEN)
 
 /** Max length of channel name */
@@ -77,9 +87,24 @@
 /** Period of Heartbeat when Unsynced */
 #define HEATBEAT_PERIOD_UNSYNCED (1000U)
 
-/** Max number of attempts at receiving a Frame before resetting RX Buffer */
+/**
+ * Max number of attempts at receiving a Frame before discarding the first byte of the RX window,
+ * with the default integrity policy and payload length. The server uses its maximum frame length.
+ */
 #define MAX_RX_ATTEMPTS (MAX_FRAME_LEN)
 
+/** Max number of payload fragments of a gather send. */
+#define MAX_TX_FRAGMENTS (8U)
+
+/** Number of the channel carrying super-frames. It is not available as Data Channel if super-frames are used. */
+#define SUPER_FRAME_CHANNEL_NUMBER (0xFFU)
+
+/** Length of the header of a record in a super-frame: Channel and length of the payload. */
+#define SUPER_FRAME_RECORD_HEADER_LEN (CHANNEL_LEN + DLC_LEN)
+
+/** Number of priority classes of TX frames. See TxPriority. */
+#define TX_PRIORITY_CLASSES (4U)
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
@@ -87,6 +112,7 @@
 /**
  * Channel Notification Prototype Callback.
  * Provides the received data in the respective channel to the application.
+ * The payload points into the RX buffer of the server and is only valid during the callback.
  *
  * @param[in] payload       Received data.
  * @param[in] payloadSize   Size of the received data.
@@ -102,6 +128,17 @@ typedef void (*ChannelCallback)(const uint8_t* payload, uint8_t payloadSize, voi
  */
 typedef void (*EventCallback)(void* userData);
 
+/**
+ * Priority class of TX frames. Frames of a higher class are written before frames of a lower class.
+ */
+enum TxPriority : uint8_t
+{
+    TX_PRIORITY_CONTROL = 0x00, /**< Control Channel, including SYNC and SCRB_RSP. Reserved for the server. */
+    TX_PRIORITY_HIGH,           /**< Data channels with critical commands. */
+    TX_PRIORITY_NORMAL,         /**< Data channels by default. */
+    TX_PRIORITY_LOW,            /**< Data channels with bulk data. */
+};
+
 /**
  * Channel Definition.
  */
@@ -110,11 +147,234 @@ struct Channel
     char            m_name[CHANNEL_NAME_MAX_LEN]; /**< Name of the channel. */
     uint8_t         m_dlc;                        /**< Payload length of channel */
     ChannelCallback m_callback;                   /**< Callback to provide received data to the application. */
+    uint8_t         m_generation;                 /**< Generation of the channel slot. 0 if not assigned. */
+    TxPriority      m_priority;                   /**< Priority class of a TX channel. */
 
     /**
      * Channel Constructor.
      */
-    Channel() : m_name{0U}, m_dlc(0U), m_callback(nullptr)
+    Channel() : m_name{0U}, m_dlc(0U), m_callback(nullptr), m_generation(0U), m_priority(TX_PRIORITY_NORMAL)
+    {
+    }
+};
+
+/**
+ * Resolved handle of a channel.
+ * It is obtained once by name and allows to address the channel afterwards without any name lookup.
+ * A handle becomes stale when the channel slot it refers to is assigned again.
+ */
+struct ChannelHandle
+{
+    uint8_t m_channelNumber; /**< Number of the channel. */
+    uint8_t m_generation;    /**< Generation of the channel slot at resolution time. 0 if invalid. */
+
+    /**
+     * ChannelHandle Constructor.
+     * Creates an invalid handle.
+     */
+    ChannelHandle() : m_channelNumber(0U), m_generation(0U)
+    {
+    }
+
+    /**
+     * Check if the handle has been resolved.
+     * @returns true if the handle refers to a channel, otherwise false.
+     */
+    bool isResolved() const
+    {
+        return (0U != m_generation);
+    }
+};
+
+/**
+ * Fragment of a payload, used for gather sends and vectored writes.
+ */
+struct IoVector
+{
+    const void* m_data;   /**< Start of the fragment. */
+    uint16_t    m_length; /**< Length of the fragment in bytes. */
+
+    /**
+     * IoVector Constructor.
+     * Creates an empty fragment.
+     */
+    IoVector() : m_data(nullptr), m_length(0U)
+    {
+    }
+
+    /**
+     * IoVector Constructor.
+     * @param[in] data Start of the fragment.
+     * @param[in] length Length of the fragment in bytes.
+     */
+    IoVector(const void* data, uint16_t length) : m_data(data), m_length(length)
+    {
+    }
+};
+
+/**
+ * Optional interface for Streams able to write several fragments with a single call, e.g. with writev().
+ * It is registered with the server in addition to the Stream, as the Arduino Stream can not be extended.
+ */
+class VectoredWriter
+{
+public:
+    /**
+     * Destroy the VectoredWriter.
+     */
+    virtual ~VectoredWriter()
+    {
+    }
+
+    /**
+     * Write several fragments in order with a single call.
+     * @param[in] vectors Fragments to write.
+     * @param[in] count Number of fragments.
+     * @returns Number of bytes written.
+     */
+    virtual size_t writev(const IoVector* vectors, uint8_t count) = 0;
+
+protected:
+    /**
+     * Construct the VectoredWriter.
+     */
+    VectoredWriter()
+    {
+    }
+};
+
+/**
+ * Optional source of received bytes, e.g. a ring filled by an interrupt service routine or DMA.
+ * It is registered with the server in addition to the Stream and replaces the Stream for reading.
+ */
+class RxSource
+{
+public:
+    /**
+     * Destroy the RxSource.
+     */
+    virtual ~RxSource()
+    {
+    }
+
+    /**
+     * Check if there are available bytes.
+     * @returns Number of available bytes.
+     */
+    virtual int available() = 0;
+
+    /**
+     * Read bytes into a buffer.
+     * @param[in] buffer Array to write bytes to.
+     * @param[in] length Number of bytes to be read.
+     * @returns Number of bytes read.
+     */
+    virtual size_t readBytes(uint8_t* buffer, size_t length) = 0;
+
+protected:
+    /**
+     * Construct the RxSource.
+     */
+    RxSource()
+    {
+    }
+};
+
+/**
+ * Optional source of frames to be sent, e.g. a queue filled by other threads.
+ * It is registered with the server, which sends its pending frames in process().
+ */
+class TxSource
+{
+public:
+    /**
+     * Destroy the TxSource.
+     */
+    virtual ~TxSource()
+    {
+    }
+
+    /**
+     * Get the oldest pending frame. It stays pending until pop() is called.
+     * @param[out] channelNumber Channel to send the frame to.
+     * @param[out] payload Payload of the frame.
+     * @param[out] payloadSize Size of the payload.
+     * @returns true if a frame is pending, otherwise false.
+     */
+    virtual bool front(uint8_t& channelNumber, const uint8_t*& payload, uint8_t& payloadSize) = 0;
+
+    /**
+     * Release the oldest pending frame, after it has been handed over to the server.
+     */
+    virtual void pop() = 0;
+
+protected:
+    /**
+     * Construct the TxSource.
+     */
+    TxSource()
+    {
+    }
+};
+
+/**
+ * Result of a bounded RX run.
+ * Allows the application to decide whether to process the RX data again.
+ */
+struct RxDrainResult
+{
+    uint16_t m_dispatchedFrames; /**< Number of valid frames dispatched to their channel. */
+    uint32_t m_pendingBytes;     /**< Number of bytes still pending to be processed. */
+
+    /**
+     * RxDrainResult Constructor.
+     */
+    RxDrainResult() : m_dispatchedFrames(0U), m_pendingBytes(0U)
+    {
+    }
+};
+
+/**
+ * Statistics of the RX path.
+ * A resynchronization starts with the first discarded byte and ends with the next valid frame.
+ */
+struct RxStatistics
+{
+    uint32_t m_resyncEvents;             /**< Number of resynchronizations started. */
+    uint32_t m_discardedBytes;           /**< Total number of bytes discarded while resynchronizing. */
+    uint32_t m_lastResyncDiscardedBytes; /**< Number of bytes discarded by the last finished resynchronization. */
+    uint32_t m_maxResyncDiscardedBytes;  /**< Maximum number of bytes discarded by a single resynchronization. */
+
+    /**
+     * RxStatistics Constructor.
+     */
+    RxStatistics() :
+        m_resyncEvents(0U),
+        m_discardedBytes(0U),
+        m_lastResyncDiscardedBytes(0U),
+        m_maxResyncDiscardedBytes(0U)
+    {
+    }
+};
+
+/**
+ * Statistics of the TX path.
+ */
+struct TxStatistics
+{
+    uint32_t m_suppressedFrames; /**< Number of frames not sent, as the remote is not subscribed to their channel. */
+    uint32_t m_supersededFrames; /**< Number of queued frames of conflated channels replaced by a newer frame. */
+
+    /**
+     * Worst-case queueing delay in milliseconds per priority class: Longest time from queueing a frame until all
+     * frames of its class have been written. Measured with the timestamps of process().
+     */
+    uint32_t m_maxQueueingDelay[TX_PRIORITY_CLASSES];
+
+    /**
+     * TxStatistics Constructor.
+     */
+    TxStatistics() : m_suppressedFrames(0U), m_supersededFrames(0U), m_maxQueueingDelay{0U}
     {
     }
 };
@@ -173,6 +433,20 @@ enum COMMANDS : uint8_t
     SCRB_RSP,    /**< Subscribe Response */
 };
 
+/**
+ * Result of sending a frame.
+ */
+enum SendStatus : uint8_t
+{
+    SEND_REJECTED = 0x00, /**< Frame not accepted: Invalid channel or payload, or not synced. */
+    SEND_QUEUE_FULL,      /**< Frame not accepted: No space in the TX queue, or in the Stream without TX queue. */
+    SEND_QUEUED,          /**< Frame accepted and waiting in the TX queue. */
+    SEND_SENT,            /**< Frame completely written to the Stream. */
+    SEND_SUPPRESSED,      /**< Frame not sent: The remote is not subscribed to the channel. */
+    SEND_DROPPED,         /**< Frame not sent: The rate limit of the channel is exceeded. */
+    SEND_DEFERRED,        /**< Frame accepted and held back by the rate limit of the channel. */
+};
+
 /**
  * Control Channel Payload Structure.
  */
@@ -0,0 +1,577 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Event loop of SerialMuxProt, driving many links in one thread with epoll.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_EVENT_LOOP_H
+#define SERIALMUXPROT_EVENT_LOOP_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <SerialMuxProtPosixStream.hpp>
+#include <limits.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Default maximum number of frames a link processes per readable event, so a busy link can not starve others. */
+#define EVENT_LOOP_MAX_FRAMES_PER_EVENT (16U)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Link driven by the event loop: a server together with the descriptor of its Stream.
+ * Hides the template parameters of the server, so links of different servers can be registered with one loop.
+ */
+class EventLoopLink
+{
+public:
+    /**
+     * Destroy the EventLoopLink.
+     */
+    virtual ~EventLoopLink()
+    {
+    }
+
+    /**
+     * Get the descriptor to wait on.
+     * @returns Descriptor, or -1 if closed.
+     */
+    virtual int getFd() const = 0;
+
+    /**
+     * Check if the link is still usable, e.g. the peer has not closed the connection.
+     * @returns true if open, otherwise false.
+     */
+    virtual bool isOpen() const = 0;
+
+    /**
+     * Do the work of the link: heartbeat, receiving if readable, and sending pending frames.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @param[in] isReadable Has the descriptor become readable?
+     */
+    virtual void process(uint32_t currentTimestamp, bool isReadable) = 0;
+
+    /**
+     * Mark the link as not usable anymore, as the peer has closed the connection or an error occurred.
+     */
+    virtual void setHungUp() = 0;
+
+    /**
+     * Get the time until the link has to be processed at the latest, if its descriptor stays idle.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @returns Time in milliseconds. 0 if due now.
+     */
+    virtual uint32_t getTimeToNextDeadline(uint32_t currentTimestamp) = 0;
+
+    /**
+     * Check if bytes are waiting for the descriptor to become writable.
+     * @returns true if bytes are pending, otherwise false.
+     */
+    virtual bool isTxPending() const = 0;
+
+protected:
+    /**
+     * Construct the EventLoopLink.
+     */
+    EventLoopLink()
+    {
+    }
+};
+
+/**
+ * Link of a SerialMuxProt server over a PosixStream.
+ * The server should have an RX buffer (tRxBufferSize), so every readable event moves all received bytes out of
+ * the kernel. Without it, an incomplete frame stays in the kernel and keeps the descriptor readable.
+ * @tparam tServer Type of the server.
+ */
+template<typename tServer>
+class SerialMuxProtLink : public EventLoopLink
+{
+public:
+    /**
+     * Construct the link.
+     * @param[in] server Server of the link.
+     * @param[in] stream Stream the server uses.
+     * @param[in] maxFramesPerEvent Maximum number of frames processed per readable event.
+     */
+    SerialMuxProtLink(tServer& server, PosixStream& stream,
+                      uint16_t maxFramesPerEvent = EVENT_LOOP_MAX_FRAMES_PER_EVENT) :
+        EventLoopLink(),
+        m_server(server),
+        m_stream(stream),
+        m_maxFramesPerEvent(maxFramesPerEvent),
+        m_isRxBacklogged(false)
+    {
+    }
+
+    /**
+     * Destroy the link.
+     */
+    ~SerialMuxProtLink()
+    {
+    }
+
+    /**
+     * Get the descriptor of the Stream.
+     * @returns Descriptor, or -1 if closed.
+     */
+    int getFd() const final
+    {
+        return m_stream.getFd();
+    }
+
+    /**
+     * Check if the Stream is still usable.
+     * @returns true if open, otherwise false.
+     */
+    bool isOpen() const final
+    {
+        return m_stream.isOpen();
+    }
+
+    /**
+     * Process the server. Received frames are only processed if the descriptor is readable, or frames are left
+     * from the last readable event.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @param[in] isReadable Has the descriptor become readable?
+     */
+    void process(uint32_t currentTimestamp, bool isReadable) final
+    {
+        RxDrainResult result;
+
+        if ((true == isReadable) || (true == m_isRxBacklogged))
+        {
+            result           = m_server.process(currentTimestamp, m_maxFramesPerEvent, UINT32_MAX);
+            m_isRxBacklogged = ((m_maxFramesPerEvent <= result.m_dispatchedFrames) && (0U != result.m_pendingBytes));
+        }
+        else
+        {
+            (void)m_server.process(currentTimestamp, 0U, 0U);
+        }
+    }
+
+    /**
+     * Mark the Stream as not usable anymore.
+     */
+    void setHungUp() final
+    {
+        m_stream.setHungUp();
+    }
+
+    /**
+     * Get the time until the server has to be processed at the latest.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @returns Time in milliseconds. 0 if due now, e.g. frames are left from the last readable event.
+     */
+    uint32_t getTimeToNextDeadline(uint32_t currentTimestamp) final
+    {
+        return (true == m_isRxBacklogged) ? 0U : m_server.getTimeToNextDeadline(currentTimestamp);
+    }
+
+    /**
+     * Check if bytes are waiting for the Stream to become writable.
+     * @returns true if bytes are pending, otherwise false.
+     */
+    bool isTxPending() const final
+    {
+        return m_server.isTxPending();
+    }
+
+private:
+    /**
+     * Server of the link.
+     */
+    tServer& m_server;
+
+    /**
+     * Stream the server uses.
+     */
+    PosixStream& m_stream;
+
+    /**
+     * Maximum number of frames processed per readable event.
+     */
+    uint16_t m_maxFramesPerEvent;
+
+    /**
+     * Are received frames left, as the frame budget of the last event was exhausted?
+     */
+    bool m_isRxBacklogged;
+
+private:
+    /* Not allowed. */
+    SerialMuxProtLink();                                         /**< Default Constructor */
+    SerialMuxProtLink(const SerialMuxProtLink& link);            /**< Copy Constructor */
+    SerialMuxProtLink& operator=(const SerialMuxProtLink& link); /**< Assignment Operator */
+};
+
+/**
+ * Event loop driving many links in one thread.
+ * It sleeps in epoll_wait() until a descriptor is readable, a descriptor with pending bytes is writable,
+ * the earliest deadline of a link (e.g. its heartbeat) is due, or wakeUp() is called. Only the links with an
+ * event or a due deadline are processed, so the load scales with the traffic instead of the number of links.
+ *
+ * Example:
+ * @code
+ * SerialMuxProtEventLoop<64U> gEventLoop;
+ * SerialMuxProtLink<Server>   gBoardLink(gBoardServer, gBoardStream);
+ *
+ * (void)gEventLoop.addLink(&gBoardLink);
+ *
+ * while (true == gIsRunning)
+ * {
+ *     (void)gEventLoop.runOnce(1000U);
+ * }
+ * @endcode
+ *
+ * The loop passes its own monotonic timestamps (see getTimestamp()) to the servers. Servers of the loop
+ * must only be used from the thread running it. Other threads publish frames through a TxSource and call
+ * wakeUp() afterwards.
+ *
+ * @note Only available on Linux.
+ * @tparam tMaxLinks Maximum number of links.
+ */
+template<uint8_t tMaxLinks>
+class SerialMuxProtEventLoop
+{
+public:
+    /**
+     * Construct the event loop.
+     */
+    SerialMuxProtEventLoop() :
+        m_epollFd(epoll_create1(EPOLL_CLOEXEC)),
+        m_wakeUpFd(eventfd(0U, (EFD_NONBLOCK | EFD_CLOEXEC))),
+        m_links{nullptr},
+        m_isWriteArmed{false},
+        m_numberOfLinks(0U)
+    {
+        if ((0 <= m_epollFd) && (0 <= m_wakeUpFd))
+        {
+            struct epoll_event event;
+
+            event.events   = EPOLLIN;
+            event.data.u32 = WAKE_UP_ID;
+
+            if (0 != epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeUpFd, &event))
+            {
+                (void)close(m_wakeUpFd);
+                m_wakeUpFd = -1;
+            }
+        }
+    }
+
+    /**
+     * Destroy the event loop. The links are not closed.
+     */
+    ~SerialMuxProtEventLoop()
+    {
+        if (0 <= m_wakeUpFd)
+        {
+            (void)close(m_wakeUpFd);
+        }
+
+        if (0 <= m_epollFd)
+        {
+            (void)close(m_epollFd);
+        }
+    }
+
+    /**
+     * Check if the event loop could be created.
+     * @returns true if usable, otherwise false.
+     */
+    bool isValid() const
+    {
+        return ((0 <= m_epollFd) && (0 <= m_wakeUpFd));
+    }
+
+    /**
+     * Register a link. Its descriptor must be opened already.
+     * @param[in] link Link to register.
+     * @returns true if registered, otherwise false if the loop is full or the descriptor can not be watched.
+     */
+    bool addLink(EventLoopLink* link)
+    {
+        bool isAdded = false;
+
+        if ((true == isValid()) && (nullptr != link) && (true == link->isOpen()) && (tMaxLinks > m_numberOfLinks) &&
+            (tMaxLinks == findLink(link)))
+        {
+            uint8_t            idx = findLink(nullptr);
+            struct epoll_event event;
+
+            event.events   = (EPOLLIN | EPOLLRDHUP);
+            event.data.u32 = idx;
+
+            if (0 == epoll_ctl(m_epollFd, EPOLL_CTL_ADD, link->getFd(), &event))
+            {
+                m_links[idx]        = link;
+                m_isWriteArmed[idx] = false;
+                m_numberOfLinks++;
+                isAdded = true;
+            }
+        }
+
+        return isAdded;
+    }
+
+    /**
+     * Unregister a link. Links which are not open anymore are unregistered by the loop itself.
+     * @param[in] link Link to unregister.
+     * @returns true if unregistered, otherwise false if the link is unknown.
+     */
+    bool removeLink(EventLoopLink* link)
+    {
+        bool    isRemoved = false;
+        uint8_t idx       = findLink(link);
+
+        if ((nullptr != link) && (tMaxLinks > idx))
+        {
+            struct epoll_event event;
+
+            /* Fails if the descriptor has been closed already, which removed it from the epoll set. */
+            (void)epoll_ctl(m_epollFd, EPOLL_CTL_DEL, link->getFd(), &event);
+
+            m_links[idx] = nullptr;
+            m_numberOfLinks--;
+            isRemoved = true;
+        }
+
+        return isRemoved;
+    }
+
+    /**
+     * Get the number of registered links.
+     * @returns Number of links.
+     */
+    uint8_t getNumberOfLinks() const
+    {
+        return m_numberOfLinks;
+    }
+
+    /**
+     * Wake the loop up, e.g. after frames have been published to a TxSource of a link. Can be called from any
+     * thread. The deadlines of all links are checked again.
+     */
+    void wakeUp()
+    {
+        uint64_t increment = 1U;
+
+        (void)write(m_wakeUpFd, &increment, sizeof(increment));
+    }
+
+    /**
+     * Wait for events, and process the links with events or due deadlines.
+     * @param[in] maxWaitTime Maximum time to wait in milliseconds.
+     * @returns Number of processed links.
+     */
+    uint8_t runOnce(uint32_t maxWaitTime)
+    {
+        struct epoll_event events[tMaxLinks + 1U];
+        bool               isProcessed[tMaxLinks] = {false};
+        uint8_t            processedLinks         = 0U;
+        uint32_t           timestamp              = getTimestamp();
+        uint32_t           waitTime               = maxWaitTime;
+        int                eventCount             = 0;
+
+        for (uint8_t idx = 0U; idx < tMaxLinks; idx++)
+        {
+            if (nullptr != m_links[idx])
+            {
+                uint32_t linkWaitTime = m_links[idx]->getTimeToNextDeadline(timestamp);
+
+                updateWriteInterest(idx);
+                waitTime = (linkWaitTime < waitTime) ? linkWaitTime : waitTime;
+            }
+        }
+
+        eventCount = epoll_wait(m_epollFd, events, (tMaxLinks + 1U),
+                                static_cast<int>((static_cast<uint32_t>(INT_MAX) < waitTime) ? INT_MAX : waitTime));
+        timestamp  = getTimestamp();
+
+        /* Links with events. */
+        for (int eventIdx = 0; eventIdx < eventCount; eventIdx++)
+        {
+            uint32_t idx = events[eventIdx].data.u32;
+
+            if (WAKE_UP_ID == idx)
+            {
+                uint64_t counter = 0U;
+
+                (void)read(m_wakeUpFd, &counter, sizeof(counter));
+            }
+            else if ((tMaxLinks > idx) && (nullptr != m_links[idx]) && (false == isProcessed[idx]))
+            {
+                bool isHungUp   = (0U != (events[eventIdx].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)));
+                bool isReadable = ((true == isHungUp) || (0U != (events[eventIdx].events & EPOLLIN)));
+
+                /* Bytes received before a hang-up are still processed. */
+                m_links[idx]->process(timestamp, isReadable);
+
+                if (true == isHungUp)
+                {
+                    m_links[idx]->setHungUp();
+                }
+
+                isProcessed[idx] = true;
+                processedLinks++;
+            }
+            else
+            {
+                /* Link has been removed meanwhile. */
+                ;
+            }
+        }
+
+        /* Links with due deadlines. */
+        for (uint8_t idx = 0U; idx < tMaxLinks; idx++)
+        {
+            if ((nullptr != m_links[idx]) && (false == isProcessed[idx]) &&
+                (0U == m_links[idx]->getTimeToNextDeadline(timestamp)))
+            {
+                m_links[idx]->process(timestamp, false);
+                isProcessed[idx] = true;
+                processedLinks++;
+            }
+
+            if ((true == isProcessed[idx]) && (nullptr != m_links[idx]) && (false == m_links[idx]->isOpen()))
+            {
+                (void)removeLink(m_links[idx]);
+            }
+        }
+
+        return processedLinks;
+    }
+
+    /**
+     * Get the timestamp passed to the servers: milliseconds of the monotonic clock, wrapping around.
+     * @returns Time in milliseconds.
+     */
+    static uint32_t getTimestamp()
+    {
+        struct timespec now;
+
+        (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return static_cast<uint32_t>((static_cast<uint64_t>(now.tv_sec) * 1000U) + (now.tv_nsec / 1000000));
+    }
+
+private:
+    /** Event ID of the wake-up descriptor. Links use their index as ID. */
+    static const uint32_t WAKE_UP_ID = UINT32_MAX;
+
+    /**
+     * epoll instance.
+     */
+    int m_epollFd;
+
+    /**
+     * eventfd waking the loop up.
+     */
+    int m_wakeUpFd;
+
+    /**
+     * Registered links. nullptr for free entries.
+     */
+    EventLoopLink* m_links[tMaxLinks];
+
+    /**
+     * Is the loop waiting for the descriptor of a link to become writable?
+     */
+    bool m_isWriteArmed[tMaxLinks];
+
+    /**
+     * Number of registered links.
+     */
+    uint8_t m_numberOfLinks;
+
+    /**
+     * Find a link.
+     * @param[in] link Link to find. nullptr to find a free entry.
+     * @returns Index of the link, or tMaxLinks if not found.
+     */
+    uint8_t findLink(const EventLoopLink* link) const
+    {
+        uint8_t idx = 0U;
+
+        while ((tMaxLinks > idx) && (link != m_links[idx]))
+        {
+            idx++;
+        }
+
+        return idx;
+    }
+
+    /**
+     * Wait for the descriptor of a link to become writable, as long as it has pending bytes.
+     * @param[in] idx Index of the link.
+     */
+    void updateWriteInterest(uint8_t idx)
+    {
+        bool isTxPending = m_links[idx]->isTxPending();
+
+        if (isTxPending != m_isWriteArmed[idx])
+        {
+            struct epoll_event event;
+
+            event.events   = (true == isTxPending) ? (EPOLLIN | EPOLLRDHUP | EPOLLOUT) : (EPOLLIN | EPOLLRDHUP);
+            event.data.u32 = idx;
+
+            if (0 == epoll_ctl(m_epollFd, EPOLL_CTL_MOD, m_links[idx]->getFd(), &event))
+            {
+                m_isWriteArmed[idx] = isTxPending;
+            }
+        }
+    }
+
+private:
+    /* Not allowed. */
+    SerialMuxProtEventLoop(const SerialMuxProtEventLoop& loop);            /**< Copy Constructor */
+    SerialMuxProtEventLoop& operator=(const SerialMuxProtEventLoop& loop); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_EVENT_LOOP_H */
+/** @} */
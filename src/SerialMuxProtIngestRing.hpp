@@ -0,0 +1,236 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free ingest ring of SerialMuxProt, fed from an interrupt service routine or DMA.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_INGEST_RING_H
+#define SERIALMUXPROT_INGEST_RING_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <atomic>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Single-producer/single-consumer ring of received bytes.
+ * The producer is an interrupt service routine, a DMA transfer callback or a thread, which calls push().
+ * The consumer is the server, which reads the ring in process() after it has been registered with setRxSource().
+ * Both sides only use atomic loads and stores of their own index, no locks and no interrupt masking.
+ * Bytes not fitting into the ring are dropped and counted.
+ *
+ * Example:
+ * @code
+ * SerialMuxProtIngestRing<256U> gRxRing;
+ *
+ * void uartRxIsr()
+ * {
+ *     uint8_t byte = UART_DATA_REGISTER;
+ *
+ *     (void)gRxRing.push(byte);
+ * }
+ *
+ * gSmpServer.setRxSource(&gRxRing);
+ * @endcode
+ *
+ * @note Requires a target with lock-free 16-bit and 32-bit atomics.
+ * @tparam tSize Size of the ring in bytes. Must be a power of two, so the free-running indices wrap around evenly.
+ */
+template<uint16_t tSize>
+class SerialMuxProtIngestRing : public RxSource
+{
+public:
+    static_assert((0U != tSize) && (0U == (tSize & (tSize - 1U))), "Ring size must be a power of two.");
+    static_assert(0x8000U >= tSize, "Ring size must fit into the range of the indices.");
+    static_assert(2 == ATOMIC_SHORT_LOCK_FREE, "Indices must be lock-free.");
+    static_assert(2 == ATOMIC_INT_LOCK_FREE, "Counter of dropped bytes must be lock-free.");
+
+    /**
+     * Construct the ingest ring.
+     */
+    SerialMuxProtIngestRing() : RxSource(), m_storage{0U}, m_writeIdx(0U), m_readIdx(0U), m_droppedBytes(0U)
+    {
+    }
+
+    /**
+     * Destroy the ingest ring.
+     */
+    ~SerialMuxProtIngestRing()
+    {
+    }
+
+    /**
+     * Append received bytes. Producer side, may be called from interrupt context.
+     * @param[in] data Received bytes.
+     * @param[in] length Number of received bytes.
+     * @returns Number of bytes appended. The others are dropped, as the ring is full.
+     */
+    uint16_t push(const uint8_t* data, uint16_t length)
+    {
+        const uint16_t writeIdx  = m_writeIdx.load(std::memory_order_relaxed);
+        const uint16_t readIdx   = m_readIdx.load(std::memory_order_acquire);
+        const uint16_t freeSpace = tSize - static_cast<uint16_t>(writeIdx - readIdx);
+        uint16_t       toWrite   = (freeSpace < length) ? freeSpace : length;
+
+        if (nullptr == data)
+        {
+            toWrite = 0U;
+        }
+        else if (0U != toWrite)
+        {
+            const uint16_t offset    = writeIdx & (tSize - 1U);
+            const uint16_t chunkSize = ((tSize - offset) < toWrite) ? (tSize - offset) : toWrite;
+
+            memcpy(&m_storage[offset], data, chunkSize);
+            memcpy(&m_storage[0U], &data[chunkSize], (toWrite - chunkSize));
+
+            /* Publish the bytes to the consumer. */
+            m_writeIdx.store(static_cast<uint16_t>(writeIdx + toWrite), std::memory_order_release);
+        }
+        else
+        {
+            /* Ring is full. */
+            ;
+        }
+
+        if (length != toWrite)
+        {
+            m_droppedBytes.store((m_droppedBytes.load(std::memory_order_relaxed) + (length - toWrite)),
+                                 std::memory_order_relaxed);
+        }
+
+        return toWrite;
+    }
+
+    /**
+     * Append a single received byte. Producer side, may be called from interrupt context.
+     * @param[in] byte Received byte.
+     * @returns true if the byte has been appended, otherwise false if it is dropped, as the ring is full.
+     */
+    bool push(uint8_t byte)
+    {
+        return (1U == push(&byte, 1U));
+    }
+
+    /**
+     * Get the number of bytes waiting to be read. Consumer side.
+     * @returns Number of available bytes.
+     */
+    int available() final
+    {
+        return static_cast<uint16_t>(m_writeIdx.load(std::memory_order_acquire) -
+                                     m_readIdx.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Read bytes out of the ring. Consumer side.
+     * @param[in] buffer Array to write bytes to.
+     * @param[in] length Number of bytes to be read.
+     * @returns Number of bytes read.
+     */
+    size_t readBytes(uint8_t* buffer, size_t length) final
+    {
+        const uint16_t readIdx        = m_readIdx.load(std::memory_order_relaxed);
+        const uint16_t writeIdx       = m_writeIdx.load(std::memory_order_acquire);
+        const uint16_t availableBytes = static_cast<uint16_t>(writeIdx - readIdx);
+        uint16_t       toRead         = (availableBytes < length) ? availableBytes : static_cast<uint16_t>(length);
+
+        if ((nullptr != buffer) && (0U != toRead))
+        {
+            const uint16_t offset    = readIdx & (tSize - 1U);
+            const uint16_t chunkSize = ((tSize - offset) < toRead) ? (tSize - offset) : toRead;
+
+            memcpy(buffer, &m_storage[offset], chunkSize);
+            memcpy(&buffer[chunkSize], &m_storage[0U], (toRead - chunkSize));
+
+            /* Release the space to the producer. */
+            m_readIdx.store(static_cast<uint16_t>(readIdx + toRead), std::memory_order_release);
+        }
+        else
+        {
+            toRead = 0U;
+        }
+
+        return toRead;
+    }
+
+    /**
+     * Get the number of bytes dropped, as the ring was full.
+     * @returns Number of dropped bytes.
+     */
+    uint32_t getDroppedBytes() const
+    {
+        return m_droppedBytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * Ring storage.
+     */
+    uint8_t m_storage[tSize];
+
+    /**
+     * Free-running index of the next byte to write. Only written by the producer.
+     */
+    std::atomic<uint16_t> m_writeIdx;
+
+    /**
+     * Free-running index of the next byte to read. Only written by the consumer.
+     */
+    std::atomic<uint16_t> m_readIdx;
+
+    /**
+     * Number of dropped bytes. Only written by the producer.
+     */
+    std::atomic<uint32_t> m_droppedBytes;
+
+private:
+    /* Not allowed. */
+    SerialMuxProtIngestRing(const SerialMuxProtIngestRing& ring);            /**< Copy Constructor */
+    SerialMuxProtIngestRing& operator=(const SerialMuxProtIngestRing& ring); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_INGEST_RING_H */
+/** @} */
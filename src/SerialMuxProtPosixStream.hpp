@@ -0,0 +1,889 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Non-blocking Stream over a POSIX file descriptor, for serial ports, pseudo-terminals and sockets.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_POSIX_STREAM_H
+#define SERIALMUXPROT_POSIX_STREAM_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <Stream.h>
+#include <SerialMuxProtCommon.hpp>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/serial.h>
+#endif /* defined(__linux__) */
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Assumed size of the kernel TX buffer of a terminal, used to report availableForWrite(). */
+#define POSIX_STREAM_TTY_TX_CAPACITY (4096U)
+
+/** Maximum length of a text written by print() and println(). */
+#define POSIX_STREAM_MAX_TEXT_LEN (64U)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Non-blocking Stream over a POSIX file descriptor.
+ * It can be opened on a termios serial port, a pseudo-terminal, a TCP connection or a UNIX-domain socket,
+ * or take over an already opened descriptor, e.g. an accepted connection. It is used by the server like any
+ * other Stream, and can also be registered as VectoredWriter to write a frame with a single writev().
+ *
+ * Reads never block: available() reports the bytes queued in the kernel, and readBytes() reads as many of them
+ * as requested with a single read(), so a server with RX buffer drains the descriptor in bulk. Writes never block
+ * either: bytes not accepted by the kernel are reported as not written, and kept by the server.
+ *
+ * Example:
+ * @code
+ * PosixStream                             gStream;
+ * SerialMuxProtServer<MAX_CHANNELS, 256U> gSmpServer(gStream);
+ *
+ * if (true == gStream.openSerial("/dev/ttyUSB0", 115200U))
+ * {
+ *     gSmpServer.setVectoredWriter(&gStream);
+ * }
+ * @endcode
+ *
+ * @note Only available on POSIX hosts.
+ */
+class PosixStream : public Stream, public VectoredWriter
+{
+public:
+    /**
+     * Construct the Stream, without descriptor.
+     */
+    PosixStream() : Stream(), VectoredWriter(), m_fd(-1), m_ptyPeerFd(-1), m_isSocket(false), m_isHungUp(false)
+    {
+    }
+
+    /**
+     * Destroy the Stream. Closes the descriptor.
+     */
+    ~PosixStream()
+    {
+        close();
+    }
+
+    /**
+     * Open a serial port with low-latency settings: raw mode, 8N1, no flow control, and reads returning
+     * immediately (VMIN = 0, VTIME = 0). On Linux, the low-latency flag of the driver is set if supported.
+     * @param[in] device Path of the serial port, e.g. "/dev/ttyUSB0".
+     * @param[in] baudRate Baud rate, e.g. 115200.
+     * @returns true if the port has been opened, otherwise false.
+     */
+    bool openSerial(const char* device, uint32_t baudRate)
+    {
+        bool    isOpened = false;
+        speed_t speed    = 0U;
+
+        close();
+
+        if ((nullptr != device) && (true == getSpeed(baudRate, speed)))
+        {
+            int fd = ::open(device, (O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC));
+
+            if (0 <= fd)
+            {
+                if (true == configureTerminal(fd, speed))
+                {
+                    setLowLatency(fd);
+                    (void)tcflush(fd, TCIOFLUSH);
+                    m_fd     = fd;
+                    isOpened = true;
+                }
+                else
+                {
+                    (void)::close(fd);
+                }
+            }
+        }
+
+        return isOpened;
+    }
+
+    /**
+     * Open a new pseudo-terminal. The Stream uses its master side. The peer, e.g. a client or a simulator,
+     * opens the terminal returned by getPeerName(). The terminal is configured in raw mode.
+     * @returns true if the pseudo-terminal has been opened, otherwise false.
+     */
+    bool openPseudoTerminal()
+    {
+        bool isOpened = false;
+        int  fd       = -1;
+
+        close();
+
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+        if (0 <= fd)
+        {
+            const char* peerName = nullptr;
+            int         peerFd   = -1;
+
+            if ((0 == grantpt(fd)) && (0 == unlockpt(fd)))
+            {
+                peerName = ptsname(fd);
+            }
+
+            if (nullptr != peerName)
+            {
+                peerFd = ::open(peerName, (O_RDWR | O_NOCTTY | O_CLOEXEC));
+            }
+
+            /* The peer side is kept open, so the master does not see a hang-up until the peer has opened it. */
+            if ((0 <= peerFd) && (true == configureTerminal(peerFd, B0)) && (true == setNonBlocking(fd)))
+            {
+                (void)fcntl(fd, F_SETFD, FD_CLOEXEC);
+                m_fd        = fd;
+                m_ptyPeerFd = peerFd;
+                isOpened    = true;
+            }
+            else
+            {
+                if (0 <= peerFd)
+                {
+                    (void)::close(peerFd);
+                }
+
+                (void)::close(fd);
+            }
+        }
+
+        return isOpened;
+    }
+
+    /**
+     * Connect to a TCP server. Nagle's algorithm is disabled, so frames are sent immediately.
+     * The connection is established blocking, the Stream is non-blocking afterwards.
+     * @param[in] host Host name or address of the server.
+     * @param[in] port Port of the server.
+     * @returns true if connected, otherwise false.
+     */
+    bool connectTcp(const char* host, uint16_t port)
+    {
+        bool             isConnected = false;
+        struct addrinfo  hints;
+        struct addrinfo* addresses   = nullptr;
+        char             service[6U] = {0};
+
+        close();
+
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        (void)snprintf(service, sizeof(service), "%u", port);
+
+        if ((nullptr != host) && (0 == getaddrinfo(host, service, &hints, &addresses)))
+        {
+            for (struct addrinfo* address = addresses; (nullptr != address) && (false == isConnected);
+                 address                  = address->ai_next)
+            {
+                int fd = socket(address->ai_family, (address->ai_socktype | SOCK_CLOEXEC), address->ai_protocol);
+
+                if (0 <= fd)
+                {
+                    if (0 == connect(fd, address->ai_addr, address->ai_addrlen))
+                    {
+                        isConnected = attach(fd);
+                    }
+                    else
+                    {
+                        (void)::close(fd);
+                    }
+                }
+            }
+
+            freeaddrinfo(addresses);
+        }
+
+        return isConnected;
+    }
+
+    /**
+     * Connect to a UNIX-domain stream socket.
+     * The connection is established blocking, the Stream is non-blocking afterwards.
+     * @param[in] path Path of the socket.
+     * @returns true if connected, otherwise false.
+     */
+    bool connectUnix(const char* path)
+    {
+        bool               isConnected = false;
+        struct sockaddr_un address;
+
+        close();
+
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if ((nullptr != path) && (sizeof(address.sun_path) > strlen(path)))
+        {
+            int fd = socket(AF_UNIX, (SOCK_STREAM | SOCK_CLOEXEC), 0);
+
+            (void)strncpy(address.sun_path, path, (sizeof(address.sun_path) - 1U));
+
+            if (0 <= fd)
+            {
+                if (0 == connect(fd, reinterpret_cast<const struct sockaddr*>(&address), sizeof(address)))
+                {
+                    isConnected = attach(fd);
+                }
+                else
+                {
+                    (void)::close(fd);
+                }
+            }
+        }
+
+        return isConnected;
+    }
+
+    /**
+     * Take over an opened descriptor, e.g. a connection returned by accept(). It is made non-blocking, and
+     * Nagle's algorithm is disabled for TCP connections. The Stream closes the descriptor.
+     * @param[in] fd Opened descriptor.
+     * @returns true if the descriptor has been taken over, otherwise false. It is not closed then.
+     */
+    bool attach(int fd)
+    {
+        bool isAttached = false;
+
+        close();
+
+        if ((0 <= fd) && (true == setNonBlocking(fd)))
+        {
+            int       type       = 0;
+            socklen_t typeLength = sizeof(type);
+
+            if (0 == getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &typeLength))
+            {
+                int isNoDelay = 1;
+
+                /* Fails on other sockets than TCP, which is fine. */
+                (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &isNoDelay, sizeof(isNoDelay));
+                m_isSocket = true;
+            }
+
+            m_fd       = fd;
+            isAttached = true;
+        }
+
+        return isAttached;
+    }
+
+    /**
+     * Close the descriptor.
+     */
+    void close()
+    {
+        if (0 <= m_ptyPeerFd)
+        {
+            (void)::close(m_ptyPeerFd);
+            m_ptyPeerFd = -1;
+        }
+
+        if (0 <= m_fd)
+        {
+            (void)::close(m_fd);
+            m_fd = -1;
+        }
+
+        m_isSocket = false;
+        m_isHungUp = false;
+    }
+
+    /**
+     * Check if the Stream is usable. It is not anymore, once the peer has closed the connection or an I/O error
+     * occurred. The descriptor stays open until close() is called, so the application can reconnect.
+     * @returns true if open and not hung up, otherwise false.
+     */
+    bool isOpen() const
+    {
+        return ((0 <= m_fd) && (false == m_isHungUp));
+    }
+
+    /**
+     * Mark the Stream as not usable anymore, e.g. after poll() reported that the peer has closed the connection.
+     * The descriptor stays open until close() is called.
+     */
+    void setHungUp()
+    {
+        m_isHungUp = true;
+    }
+
+    /**
+     * Get the descriptor, e.g. to wait for received bytes with poll().
+     * @returns Descriptor, or -1 if closed.
+     */
+    int getFd() const
+    {
+        return m_fd;
+    }
+
+    /**
+     * Get the name of the terminal the peer has to open, if the Stream is a pseudo-terminal.
+     * @returns Path of the terminal, or nullptr if the Stream is not a pseudo-terminal.
+     */
+    const char* getPeerName() const
+    {
+        return (0 <= m_ptyPeerFd) ? ptsname(m_fd) : nullptr;
+    }
+
+    /**
+     * Print argument, without blocking.
+     * @param[in] str Argument to print.
+     */
+    void print(const char str[]) final
+    {
+        if (nullptr != str)
+        {
+            (void)write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+        }
+    }
+
+    /**
+     * Print argument as decimal number, without blocking.
+     * @param[in] value Argument to print.
+     */
+    void print(uint8_t value) final
+    {
+        printFormatted("%u", value);
+    }
+
+    /**
+     * Print argument as decimal number, without blocking.
+     * @param[in] value Argument to print.
+     */
+    void print(uint16_t value) final
+    {
+        printFormatted("%u", value);
+    }
+
+    /**
+     * Print argument as decimal number, without blocking.
+     * @param[in] value Argument to print.
+     */
+    void print(uint32_t value) final
+    {
+        printFormatted("%lu", static_cast<unsigned long>(value));
+    }
+
+    /**
+     * Print argument as decimal number, without blocking.
+     * @param[in] value Argument to print.
+     */
+    void print(int8_t value) final
+    {
+        printFormatted("%d", value);
+    }
+
+    /**
+     * Print argument as decimal number, without blocking.
+     * @param[in] value Argument to print.
+     */
+    void print(int16_t value) final
+    {
+        printFormatted("%d", value);
+    }
+
+    /**
+     * Print argument as decimal number, without blocking.
+     * @param[in] value Argument to print.
+     */
+    void print(int32_t value) final
+    {
+        printFormatted("%ld", static_cast<long>(value));
+    }
+
+    /**
+     * Print argument, followed by a line break (CR LF), without blocking.
+     * @param[in] str Argument to print.
+     */
+    void println(const char str[]) final
+    {
+        print(str);
+        print("\r\n");
+    }
+
+    /**
+     * Print argument as decimal number, followed by a line break (CR LF), without blocking.
+     * @param[in] value Argument to print.
+     */
+    void println(uint8_t value) final
+    {
+        print(value);
+        print("\r\n");
+    }
+
+    /**
+     * Print argument as decimal number, followed by a line break (CR LF), without blocking.
+     * @param[in] value Argument to print.
+     */
+    void println(uint16_t value) final
+    {
+        print(value);
+        print("\r\n");
+    }
+
+    /**
+     * Print argument as decimal number, followed by a line break (CR LF), without blocking.
+     * @param[in] value Argument to print.
+     */
+    void println(uint32_t value) final
+    {
+        print(value);
+        print("\r\n");
+    }
+
+    /**
+     * Print argument as decimal number, followed by a line break (CR LF), without blocking.
+     * @param[in] value Argument to print.
+     */
+    void println(int8_t value) final
+    {
+        print(value);
+        print("\r\n");
+    }
+
+    /**
+     * Print argument as decimal number, followed by a line break (CR LF), without blocking.
+     * @param[in] value Argument to print.
+     */
+    void println(int16_t value) final
+    {
+        print(value);
+        print("\r\n");
+    }
+
+    /**
+     * Print argument as decimal number, followed by a line break (CR LF), without blocking.
+     * @param[in] value Argument to print.
+     */
+    void println(int32_t value) final
+    {
+        print(value);
+        print("\r\n");
+    }
+
+    /**
+     * Write bytes, without blocking.
+     * @param[in] buffer Byte Array to send.
+     * @param[in] length Length of Buffer.
+     * @returns Number of bytes written. Less than length if the kernel buffer is full.
+     */
+    size_t write(const uint8_t* buffer, size_t length) final
+    {
+        IoVector vector;
+
+        vector.m_data   = buffer;
+        vector.m_length = static_cast<uint16_t>((UINT16_MAX < length) ? UINT16_MAX : length);
+
+        return writev(&vector, 1U);
+    }
+
+    /**
+     * Write several fragments in order with a single system call, without blocking.
+     * @param[in] vectors Fragments to write.
+     * @param[in] count Number of fragments.
+     * @returns Number of bytes written. Less than the sum of the fragments if the kernel buffer is full.
+     */
+    size_t writev(const IoVector* vectors, uint8_t count) final
+    {
+        struct iovec ioVectors[UINT8_MAX];
+        size_t       written = 0U;
+        ssize_t      result  = -1;
+
+        if ((true == isOpen()) && (nullptr != vectors))
+        {
+            for (uint8_t idx = 0U; idx < count; idx++)
+            {
+                ioVectors[idx].iov_base = const_cast<void*>(vectors[idx].m_data);
+                ioVectors[idx].iov_len  = vectors[idx].m_length;
+            }
+
+            do
+            {
+                if (true == m_isSocket)
+                {
+                    struct msghdr message;
+
+                    memset(&message, 0, sizeof(message));
+                    message.msg_iov    = ioVectors;
+                    message.msg_iovlen = count;
+
+                    /* A closed connection is reported as error, instead of raising SIGPIPE. */
+                    result = sendmsg(m_fd, &message, MSG_NOSIGNAL);
+                }
+                else
+                {
+                    result = ::writev(m_fd, ioVectors, count);
+                }
+            } while ((0 > result) && (EINTR == errno));
+
+            if (0 <= result)
+            {
+                written = static_cast<size_t>(result);
+            }
+            else
+            {
+                checkError();
+            }
+        }
+
+        return written;
+    }
+
+    /**
+     * Get the number of bytes that can be written without blocking, estimated from the bytes queued in the kernel.
+     * @returns Number of bytes. 0 if unknown or closed.
+     */
+    int availableForWrite() final
+    {
+        int availableBytes = 0;
+        int capacity       = static_cast<int>(POSIX_STREAM_TTY_TX_CAPACITY);
+        int queuedBytes    = 0;
+
+        if (true == m_isSocket)
+        {
+            socklen_t capacityLength = sizeof(capacity);
+
+            if (0 != getsockopt(m_fd, SOL_SOCKET, SO_SNDBUF, &capacity, &capacityLength))
+            {
+                capacity = 0;
+            }
+        }
+
+        if ((true == isOpen()) && (0 == ioctl(m_fd, TIOCOUTQ, &queuedBytes)) && (queuedBytes < capacity))
+        {
+            availableBytes = capacity - queuedBytes;
+        }
+
+        return availableBytes;
+    }
+
+    /**
+     * Get the number of bytes received and not read yet.
+     * @returns Number of available bytes.
+     */
+    int available() const final
+    {
+        int availableBytes = 0;
+
+        if ((true == isOpen()) && (0 != ioctl(m_fd, FIONREAD, &availableBytes)))
+        {
+            availableBytes = 0;
+        }
+
+        return availableBytes;
+    }
+
+    /**
+     * Read bytes with a single read(), without blocking.
+     * @param[in] buffer Array to write bytes to.
+     * @param[in] length Number of bytes to be read.
+     * @returns Number of bytes read. 0 if none are available.
+     */
+    size_t readBytes(uint8_t* buffer, size_t length) final
+    {
+        size_t  received = 0U;
+        ssize_t result   = -1;
+
+        if ((true == isOpen()) && (nullptr != buffer) && (0U != length))
+        {
+            do
+            {
+                result = ::read(m_fd, buffer, length);
+            } while ((0 > result) && (EINTR == errno));
+
+            if (0 < result)
+            {
+                received = static_cast<size_t>(result);
+            }
+            else if (0 == result)
+            {
+                /* End of file. The peer has closed the connection. */
+                m_isHungUp = true;
+            }
+            else
+            {
+                checkError();
+            }
+        }
+
+        return received;
+    }
+
+private:
+    /**
+     * Descriptor. -1 if closed.
+     */
+    int m_fd;
+
+    /**
+     * Peer side of a pseudo-terminal, kept open by the Stream. -1 if none.
+     */
+    int m_ptyPeerFd;
+
+    /**
+     * Is the descriptor a socket?
+     */
+    bool m_isSocket;
+
+    /**
+     * Has the peer closed the connection, or an I/O error occurred?
+     */
+    bool m_isHungUp;
+
+    /**
+     * Mark the Stream as hung up after a failed read or write, unless it only would have blocked.
+     */
+    void checkError()
+    {
+        if ((EAGAIN != errno) && (EWOULDBLOCK != errno) && (EINTR != errno))
+        {
+            m_isHungUp = true;
+        }
+    }
+
+    /**
+     * Write a formatted value.
+     * @param[in] format printf-style format of a single value.
+     * @param[in] value Value to write.
+     */
+    template<typename tValue>
+    void printFormatted(const char* format, tValue value)
+    {
+        char text[POSIX_STREAM_MAX_TEXT_LEN];
+        int  length = snprintf(text, sizeof(text), format, value);
+
+        if (0 < length)
+        {
+            (void)write(reinterpret_cast<const uint8_t*>(text), static_cast<size_t>(length));
+        }
+    }
+
+    /**
+     * Make a descriptor non-blocking.
+     * @param[in] fd Descriptor.
+     * @returns true if successful, otherwise false.
+     */
+    static bool setNonBlocking(int fd)
+    {
+        int flags = fcntl(fd, F_GETFL, 0);
+
+        return ((0 <= flags) && (0 == fcntl(fd, F_SETFL, (flags | O_NONBLOCK))));
+    }
+
+    /**
+     * Configure a terminal in raw mode, 8N1, without flow control. Reads return immediately.
+     * @param[in] fd Descriptor of the terminal.
+     * @param[in] speed Baud rate constant. B0 keeps the current baud rate.
+     * @returns true if successful, otherwise false.
+     */
+    static bool configureTerminal(int fd, speed_t speed)
+    {
+        bool           isConfigured = false;
+        struct termios settings;
+
+        if (0 == tcgetattr(fd, &settings))
+        {
+            cfmakeraw(&settings);
+            settings.c_cflag &= ~(CSTOPB | CRTSCTS);
+            settings.c_cflag |= (CLOCAL | CREAD);
+            settings.c_iflag &= ~(IXON | IXOFF | IXANY);
+            settings.c_cc[VMIN]  = 0U;
+            settings.c_cc[VTIME] = 0U;
+
+            if ((B0 == speed) || ((0 == cfsetispeed(&settings, speed)) && (0 == cfsetospeed(&settings, speed))))
+            {
+                isConfigured = (0 == tcsetattr(fd, TCSANOW, &settings));
+            }
+        }
+
+        return isConfigured;
+    }
+
+    /**
+     * Ask the serial driver to pass received bytes on without delay. Not all drivers support it.
+     * @param[in] fd Descriptor of the serial port.
+     */
+    static void setLowLatency(int fd)
+    {
+#if defined(__linux__) && defined(ASYNC_LOW_LATENCY)
+        struct serial_struct serialInfo;
+
+        if (0 == ioctl(fd, TIOCGSERIAL, &serialInfo))
+        {
+            serialInfo.flags |= ASYNC_LOW_LATENCY;
+            (void)ioctl(fd, TIOCSSERIAL, &serialInfo);
+        }
+#else  /* defined(__linux__) && defined(ASYNC_LOW_LATENCY) */
+        (void)fd;
+#endif /* defined(__linux__) && defined(ASYNC_LOW_LATENCY) */
+    }
+
+    /**
+     * Get the termios constant of a baud rate.
+     * @param[in] baudRate Baud rate.
+     * @param[out] speed Baud rate constant.
+     * @returns true if the baud rate is supported, otherwise false.
+     */
+    static bool getSpeed(uint32_t baudRate, speed_t& speed)
+    {
+        bool isSupported = true;
+
+        switch (baudRate)
+        {
+        case 9600U:
+            speed = B9600;
+            break;
+
+        case 19200U:
+            speed = B19200;
+            break;
+
+        case 38400U:
+            speed = B38400;
+            break;
+
+        case 57600U:
+            speed = B57600;
+            break;
+
+        case 115200U:
+            speed = B115200;
+            break;
+
+        case 230400U:
+            speed = B230400;
+            break;
+
+#if defined(B460800)
+        case 460800U:
+            speed = B460800;
+            break;
+#endif /* defined(B460800) */
+
+#if defined(B921600)
+        case 921600U:
+            speed = B921600;
+            break;
+#endif /* defined(B921600) */
+
+#if defined(B1000000)
+        case 1000000U:
+            speed = B1000000;
+            break;
+#endif /* defined(B1000000) */
+
+#if defined(B1152000)
+        case 1152000U:
+            speed = B1152000;
+            break;
+#endif /* defined(B1152000) */
+
+#if defined(B1500000)
+        case 1500000U:
+            speed = B1500000;
+            break;
+#endif /* defined(B1500000) */
+
+#if defined(B2000000)
+        case 2000000U:
+            speed = B2000000;
+            break;
+#endif /* defined(B2000000) */
+
+#if defined(B2500000)
+        case 2500000U:
+            speed = B2500000;
+            break;
+#endif /* defined(B2500000) */
+
+#if defined(B3000000)
+        case 3000000U:
+            speed = B3000000;
+            break;
+#endif /* defined(B3000000) */
+
+#if defined(B3500000)
+        case 3500000U:
+            speed = B3500000;
+            break;
+#endif /* defined(B3500000) */
+
+#if defined(B4000000)
+        case 4000000U:
+            speed = B4000000;
+            break;
+#endif /* defined(B4000000) */
+
+        default:
+            isSupported = false;
+            break;
+        }
+
+        return isSupported;
+    }
+
+private:
+    /* Not allowed. */
+    PosixStream(const PosixStream& stream);            /**< Copy Constructor */
+    PosixStream& operator=(const PosixStream& stream); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_POSIX_STREAM_H */
+/** @} */
@@ -0,0 +1,268 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Lock-free multi-producer publish queue of SerialMuxProt.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_PUBLISH_QUEUE_H
+#define SERIALMUXPROT_PUBLISH_QUEUE_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <atomic>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Bounded multi-producer/single-consumer queue of frames to be sent.
+ * Any number of threads publish frames with publish(), without locks. The server is the single consumer: It sends
+ * the frames in process() after the queue has been registered with setTxSource(), so the thread calling process(),
+ * e.g. a dedicated TX thread, is the only one writing to the Stream.
+ * Frames are sent in the order they have been published, so the order per channel is kept.
+ *
+ * Example:
+ * @code
+ * SerialMuxProtPublishQueue<64U> gPublishQueue;
+ *
+ * gSmpServer.setTxSource(&gPublishQueue);
+ *
+ * // Any thread:
+ * gPublishQueue.publish(gPlannerChannel, &plan, sizeof(plan));
+ * @endcode
+ *
+ * Each slot carries a sequence number, which tells producers and consumer whether it is free or filled
+ * for the current round of the ring. Producers reserve a slot with a compare-and-swap on the enqueue position.
+ *
+ * @note Requires lock-free atomics of the target.
+ * @tparam tSlots Number of frames the queue can hold. Must be a power of two.
+ * @tparam tMaxDataLen Maximum payload length of a frame.
+ */
+template<uint16_t tSlots, uint8_t tMaxDataLen = MAX_DATA_LEN>
+class SerialMuxProtPublishQueue : public TxSource
+{
+public:
+    static_assert((1U < tSlots) && (0U == (tSlots & (tSlots - 1U))), "Number of slots must be a power of two.");
+    static_assert(2 == ATOMIC_INT_LOCK_FREE, "Positions must be lock-free.");
+
+    /**
+     * Construct the publish queue.
+     */
+    SerialMuxProtPublishQueue() :
+        TxSource(),
+        m_slots(),
+        m_enqueuePosition(0U),
+        m_dequeuePosition(0U),
+        m_rejectedFrames(0U)
+    {
+        for (uint16_t idx = 0U; idx < tSlots; idx++)
+        {
+            m_slots[idx].m_sequence.store(idx, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Destroy the publish queue.
+     */
+    ~SerialMuxProtPublishQueue()
+    {
+    }
+
+    /**
+     * Publish a frame. Producer side, may be called from any thread.
+     * The channel is checked by the server when the frame is sent. Frames on an invalid channel are dropped then.
+     * @param[in] channelNumber Channel to send the frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send.
+     * @returns true if the frame has been queued, otherwise false if the payload is invalid or the queue is full.
+     */
+    bool publish(uint8_t channelNumber, const void* payload, uint8_t payloadSize)
+    {
+        bool isQueued = false;
+
+        if ((nullptr != payload) && (0U != payloadSize) && (tMaxDataLen >= payloadSize))
+        {
+            uint32_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+            Slot*    slot     = nullptr;
+
+            while (nullptr == slot)
+            {
+                Slot*    candidate = &m_slots[position & (tSlots - 1U)];
+                uint32_t sequence  = candidate->m_sequence.load(std::memory_order_acquire);
+                int32_t  distance  = static_cast<int32_t>(sequence - position);
+
+                if (0 == distance)
+                {
+                    /* Slot is free in this round. Reserve it, unless another producer was faster. */
+                    if (true == m_enqueuePosition.compare_exchange_weak(position, (position + 1U),
+                                                                        std::memory_order_relaxed))
+                    {
+                        slot = candidate;
+                    }
+                }
+                else if (0 > distance)
+                {
+                    /* Slot has not been consumed yet. Queue is full. */
+                    break;
+                }
+                else
+                {
+                    /* Another producer reserved the slot. */
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            if (nullptr != slot)
+            {
+                slot->m_channelNumber = channelNumber;
+                slot->m_payloadSize   = payloadSize;
+                memcpy(slot->m_payload, payload, payloadSize);
+
+                /* Hand the slot over to the consumer. */
+                slot->m_sequence.store((position + 1U), std::memory_order_release);
+                isQueued = true;
+            }
+        }
+
+        if (false == isQueued)
+        {
+            m_rejectedFrames.fetch_add(1U, std::memory_order_relaxed);
+        }
+
+        return isQueued;
+    }
+
+    /**
+     * Get the oldest published frame. Consumer side.
+     * @param[out] channelNumber Channel to send the frame to.
+     * @param[out] payload Payload of the frame.
+     * @param[out] payloadSize Size of the payload.
+     * @returns true if a frame is pending, otherwise false.
+     */
+    bool front(uint8_t& channelNumber, const uint8_t*& payload, uint8_t& payloadSize) final
+    {
+        bool  isPending = false;
+        Slot& slot      = m_slots[m_dequeuePosition & (tSlots - 1U)];
+
+        if ((m_dequeuePosition + 1U) == slot.m_sequence.load(std::memory_order_acquire))
+        {
+            channelNumber = slot.m_channelNumber;
+            payload       = slot.m_payload;
+            payloadSize   = slot.m_payloadSize;
+            isPending     = true;
+        }
+
+        return isPending;
+    }
+
+    /**
+     * Release the oldest published frame. Consumer side.
+     */
+    void pop() final
+    {
+        Slot& slot = m_slots[m_dequeuePosition & (tSlots - 1U)];
+
+        if ((m_dequeuePosition + 1U) == slot.m_sequence.load(std::memory_order_acquire))
+        {
+            /* Slot is free again in the next round. */
+            slot.m_sequence.store((m_dequeuePosition + tSlots), std::memory_order_release);
+            m_dequeuePosition++;
+        }
+    }
+
+    /**
+     * Get the number of frames not queued, as the payload was invalid or the queue was full.
+     * @returns Number of rejected frames.
+     */
+    uint32_t getRejectedFrames() const
+    {
+        return m_rejectedFrames.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * Slot of the queue.
+     */
+    struct Slot
+    {
+        std::atomic<uint32_t> m_sequence;             /**< Sequence number of the slot. */
+        uint8_t               m_channelNumber;        /**< Channel to send the frame to. */
+        uint8_t               m_payloadSize;          /**< Size of the payload. */
+        uint8_t               m_payload[tMaxDataLen]; /**< Payload of the frame. */
+
+        /**
+         * Slot Constructor.
+         */
+        Slot() : m_sequence(0U), m_channelNumber(0U), m_payloadSize(0U), m_payload{0U}
+        {
+        }
+    };
+
+    /**
+     * Slots of the queue.
+     */
+    Slot m_slots[tSlots];
+
+    /**
+     * Position of the next slot to reserve. Shared by the producers.
+     */
+    std::atomic<uint32_t> m_enqueuePosition;
+
+    /**
+     * Position of the next slot to consume. Only used by the consumer.
+     */
+    uint32_t m_dequeuePosition;
+
+    /**
+     * Number of rejected frames.
+     */
+    std::atomic<uint32_t> m_rejectedFrames;
+
+private:
+    /* Not allowed. */
+    SerialMuxProtPublishQueue(const SerialMuxProtPublishQueue& queue);            /**< Copy Constructor */
+    SerialMuxProtPublishQueue& operator=(const SerialMuxProtPublishQueue& queue); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_PUBLISH_QUEUE_H */
+/** @} */
@@ -0,0 +1,385 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Rate limiting of TX channels of SerialMuxProt.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_RATE_LIMIT_H
+#define SERIALMUXPROT_RATE_LIMIT_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <SerialMuxProtTxBuffer.hpp>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Number of token units per token. Tokens are counted in fractions to refill them every millisecond. */
+#define TOKEN_UNITS_PER_TOKEN (1000U)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Unit of a rate limit.
+ */
+enum RateLimitUnit : uint8_t
+{
+    RATE_LIMIT_FRAMES = 0x00, /**< Frames per second. */
+    RATE_LIMIT_BYTES,         /**< Bytes per second, counting the complete frame on the wire. */
+};
+
+/**
+ * Handling of frames exceeding a rate limit.
+ */
+enum RateLimitPolicy : uint8_t
+{
+    RATE_LIMIT_DROP = 0x00, /**< The frame is dropped. */
+    RATE_LIMIT_DEFER,       /**< The newest frame is kept and sent by process() once the budget allows it. */
+};
+
+/**
+ * Token bucket limiting the rate of a TX channel.
+ * It is owned by the application and registered with the server for a channel.
+ * The bucket is refilled with the timestamp passed to process() of the server.
+ *
+ * Example:
+ * @code
+ * uint8_t     gDebugDeferred[MAX_DATA_LEN];
+ * TxRateLimit gDebugRateLimit(RATE_LIMIT_BYTES, 2000U, 256U, RATE_LIMIT_DEFER, gDebugDeferred,
+ *                             sizeof(gDebugDeferred));
+ *
+ * gSmpServer.setTxChannelRateLimit(gSmpServer.createChannel("DEBUG", 32U), &gDebugRateLimit);
+ * @endcode
+ */
+class TxRateLimit
+{
+public:
+    /**
+     * Construct the token bucket. It starts full.
+     * @param[in] unit Unit of rate and burst.
+     * @param[in] rate Number of frames or bytes per second.
+     * @param[in] burst Maximum number of frames or bytes sent at once after an idle time.
+     * @param[in] policy Handling of frames exceeding the rate limit.
+     * @param[in] deferredPayload Storage for the deferred frame. Without storage, frames are dropped.
+     * @param[in] deferredPayloadSize Size of the storage. Longer payloads are dropped.
+     */
+    TxRateLimit(RateLimitUnit unit, uint32_t rate, uint32_t burst, RateLimitPolicy policy = RATE_LIMIT_DROP,
+                uint8_t* deferredPayload = nullptr, uint8_t deferredPayloadSize = 0U) :
+        m_unit(unit),
+        m_rate(rate),
+        m_capacity(toTokenUnits(burst)),
+        m_tokens(m_capacity),
+        m_lastRefill(0U),
+        m_policy(policy),
+        m_deferredPayload(deferredPayload),
+        m_deferredPayloadSize(deferredPayloadSize),
+        m_deferredLength(0U),
+        m_droppedFrames(0U),
+        m_deferredFrames(0U)
+    {
+    }
+
+    /**
+     * Destroy the token bucket.
+     */
+    ~TxRateLimit()
+    {
+    }
+
+    /**
+     * Refill the bucket and check if a frame is within the budget.
+     * @param[in] timestamp Current timestamp in milliseconds.
+     * @param[in] frameLength Length of the complete frame.
+     * @returns true if the frame can be sent, otherwise false.
+     */
+    bool isAvailable(uint32_t timestamp, uint16_t frameLength)
+    {
+        refill(timestamp);
+
+        return (getCost(frameLength) <= m_tokens);
+    }
+
+    /**
+     * Get the time until a frame is within the budget, without refilling the bucket.
+     * @param[in] timestamp Current timestamp in milliseconds.
+     * @param[in] frameLength Length of the complete frame.
+     * @returns Time in milliseconds. 0 if the frame can be sent now, UINT32_MAX if never.
+     */
+    uint32_t getWaitTime(uint32_t timestamp, uint16_t frameLength) const
+    {
+        uint32_t waitTime = UINT32_MAX;
+        uint32_t cost     = getCost(frameLength);
+        uint32_t tokens   = getRefilledTokens(timestamp);
+
+        if (cost <= tokens)
+        {
+            waitTime = 0U;
+        }
+        else if ((0U != m_rate) && (cost <= m_capacity))
+        {
+            waitTime = ((cost - tokens) + (m_rate - 1U)) / m_rate;
+        }
+        else
+        {
+            /* The bucket never holds enough tokens. */
+            ;
+        }
+
+        return waitTime;
+    }
+
+    /**
+     * Take the tokens of a sent frame out of the bucket.
+     * @param[in] frameLength Length of the complete frame.
+     */
+    void consume(uint16_t frameLength)
+    {
+        uint32_t cost = getCost(frameLength);
+
+        m_tokens = (cost < m_tokens) ? (m_tokens - cost) : 0U;
+    }
+
+    /**
+     * Handle a frame exceeding the budget according to the policy.
+     * A deferred frame replaces the one deferred before, which is counted as dropped, as it is never sent.
+     * @param[in] fragments Payload fragments, in order.
+     * @param[in] fragmentCount Number of fragments.
+     * @param[in] payloadSize Sum of the fragment lengths.
+     * @returns true if the frame has been deferred, otherwise false if it has been dropped.
+     */
+    bool defer(const IoVector* fragments, uint8_t fragmentCount, uint8_t payloadSize)
+    {
+        bool isDeferred = false;
+
+        if ((RATE_LIMIT_DEFER == m_policy) && (nullptr != m_deferredPayload) && (m_deferredPayloadSize >= payloadSize))
+        {
+            if (true == hasDeferredFrame())
+            {
+                /* The frame deferred before is lost. */
+                m_droppedFrames++;
+            }
+
+            m_deferredLength =
+                static_cast<uint8_t>(copyIoVectors(m_deferredPayload, fragments, fragmentCount, 0U, payloadSize));
+            m_deferredFrames++;
+            isDeferred = true;
+        }
+        else
+        {
+            m_droppedFrames++;
+        }
+
+        return isDeferred;
+    }
+
+    /**
+     * Check if a frame is deferred.
+     * @returns true if a deferred frame is waiting to be sent, otherwise false.
+     */
+    bool hasDeferredFrame() const
+    {
+        return (0U != m_deferredLength);
+    }
+
+    /**
+     * Get the payload of the deferred frame.
+     * @returns Payload of the deferred frame.
+     */
+    const uint8_t* getDeferredPayload() const
+    {
+        return m_deferredPayload;
+    }
+
+    /**
+     * Get the payload length of the deferred frame.
+     * @returns Payload length, or 0 if no frame is deferred.
+     */
+    uint8_t getDeferredLength() const
+    {
+        return m_deferredLength;
+    }
+
+    /**
+     * Release the deferred frame, after it has been sent.
+     */
+    void clearDeferredFrame()
+    {
+        m_deferredLength = 0U;
+    }
+
+    /**
+     * Get the number of frames dropped because of the rate limit.
+     * @returns Number of dropped frames, including deferred frames replaced by a newer deferred frame.
+     */
+    uint32_t getDroppedFrames() const
+    {
+        return m_droppedFrames;
+    }
+
+    /**
+     * Get the number of frames deferred because of the rate limit.
+     * @returns Number of deferred frames, including those replaced by a newer deferred frame and thus dropped.
+     */
+    uint32_t getDeferredFrames() const
+    {
+        return m_deferredFrames;
+    }
+
+private:
+    /**
+     * Convert a number of frames or bytes to token units.
+     * @param[in] tokens Number of frames or bytes.
+     * @returns Number of token units, saturated.
+     */
+    static uint32_t toTokenUnits(uint32_t tokens)
+    {
+        return ((UINT32_MAX / TOKEN_UNITS_PER_TOKEN) < tokens) ? UINT32_MAX : (tokens * TOKEN_UNITS_PER_TOKEN);
+    }
+
+    /**
+     * Get the cost of a frame.
+     * @param[in] frameLength Length of the complete frame.
+     * @returns Number of token units.
+     */
+    uint32_t getCost(uint16_t frameLength) const
+    {
+        return (RATE_LIMIT_BYTES == m_unit) ? toTokenUnits(frameLength) : TOKEN_UNITS_PER_TOKEN;
+    }
+
+    /**
+     * Get the tokens in the bucket after refilling it with the time elapsed since the last refill.
+     * The rate per second is the number of token units per millisecond.
+     * @param[in] timestamp Current timestamp in milliseconds.
+     * @returns Tokens in token units.
+     */
+    uint32_t getRefilledTokens(uint32_t timestamp) const
+    {
+        uint32_t elapsed = timestamp - m_lastRefill;
+        uint32_t tokens  = m_tokens;
+
+        if (0U != m_rate)
+        {
+            if (((m_capacity - m_tokens) / m_rate) < elapsed)
+            {
+                tokens = m_capacity;
+            }
+            else
+            {
+                tokens += (m_rate * elapsed);
+            }
+        }
+
+        return tokens;
+    }
+
+    /**
+     * Refill the bucket with the tokens of the time elapsed since the last refill.
+     * @param[in] timestamp Current timestamp in milliseconds.
+     */
+    void refill(uint32_t timestamp)
+    {
+        m_tokens     = getRefilledTokens(timestamp);
+        m_lastRefill = timestamp;
+    }
+
+    /**
+     * Unit of rate and burst.
+     */
+    RateLimitUnit m_unit;
+
+    /**
+     * Number of frames or bytes per second, equal to token units per millisecond.
+     */
+    uint32_t m_rate;
+
+    /**
+     * Capacity of the bucket in token units.
+     */
+    uint32_t m_capacity;
+
+    /**
+     * Tokens in the bucket in token units.
+     */
+    uint32_t m_tokens;
+
+    /**
+     * Timestamp of the last refill in milliseconds.
+     */
+    uint32_t m_lastRefill;
+
+    /**
+     * Handling of frames exceeding the rate limit.
+     */
+    RateLimitPolicy m_policy;
+
+    /**
+     * Storage for the deferred frame.
+     */
+    uint8_t* m_deferredPayload;
+
+    /**
+     * Size of the storage for the deferred frame.
+     */
+    uint8_t m_deferredPayloadSize;
+
+    /**
+     * Payload length of the deferred frame. 0 if none.
+     */
+    uint8_t m_deferredLength;
+
+    /**
+     * Number of dropped frames.
+     */
+    uint32_t m_droppedFrames;
+
+    /**
+     * Number of deferred frames.
+     */
+    uint32_t m_deferredFrames;
+
+private:
+    /* Not allowed. */
+    TxRateLimit();                                        /**< Default Constructor */
+    TxRateLimit(const TxRateLimit& rateLimit);            /**< Copy Constructor */
+    TxRateLimit& operator=(const TxRateLimit& rateLimit); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_RATE_LIMIT_H */
+/** @} */
@@ -0,0 +1,813 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Multi-core runtime of SerialMuxProt, sharding links across pinned worker threads.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_RUNTIME_H
+#define SERIALMUXPROT_RUNTIME_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <SerialMuxProtEventLoop.hpp>
+#include <atomic>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Period of the load measurement and rebalancing of the workers in milliseconds. */
+#define RUNTIME_REBALANCE_PERIOD (100U)
+
+/** Minimum load difference between two workers in microseconds per period, before a link is moved. */
+#define RUNTIME_REBALANCE_MIN_LOAD (2000U)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Runtime spreading links across worker threads, each pinned to a core and running its own event loop.
+ *
+ * A link is placed on the worker with the lowest load when added. Every worker measures the time spent processing
+ * each of its links. Once per rebalancing period, a worker with little load asks the busiest worker for a link,
+ * and the busiest worker hands over the link which evens out the load best. A link is only processed by the
+ * worker owning it, so the RX buffer and the callbacks of its server stay on one core between migrations.
+ *
+ * Frames are forwarded between links of different workers through a SerialMuxProtPublishQueue registered as
+ * TxSource of the receiving server: the callback of the sending link publishes to the queue and calls notify().
+ *
+ * Example:
+ * @code
+ * SerialMuxProtRuntime<4U, 64U>  gRuntime;
+ * SerialMuxProtPublishQueue<32U> gBoardBQueue;
+ *
+ * void onBoardAStatus(const uint8_t* payload, const uint8_t payloadSize, void* userData)
+ * {
+ *     (void)gBoardBQueue.publish(gBoardBStatusChannel, payload, payloadSize);
+ *     gRuntime.notify(&gBoardBLink);
+ * }
+ *
+ * gBoardBServer.setTxSource(&gBoardBQueue);
+ * (void)gRuntime.addLink(&gBoardALink);
+ * (void)gRuntime.addLink(&gBoardBLink);
+ * (void)gRuntime.start();
+ * @endcode
+ *
+ * addLink(), removeLink(), moveLink(), start() and stop() must be called from a single control thread.
+ * notify() can be called from any thread.
+ *
+ * @note Only available on Linux.
+ * @tparam tWorkers Number of worker threads.
+ * @tparam tMaxLinks Maximum number of links.
+ */
+template<uint8_t tWorkers, uint8_t tMaxLinks>
+class SerialMuxProtRuntime
+{
+public:
+    static_assert((0U < tWorkers) && (UINT8_MAX > tWorkers), "Number of workers must be between 1 and 254.");
+
+    /**
+     * Construct the runtime. The workers are started with start().
+     */
+    SerialMuxProtRuntime() : m_entries(), m_workers(), m_isRunning(false), m_migrations(0U)
+    {
+    }
+
+    /**
+     * Destroy the runtime. Stops the workers.
+     */
+    ~SerialMuxProtRuntime()
+    {
+        stop();
+    }
+
+    /**
+     * Start the worker threads and pin them to consecutive cores. Pinning is skipped where the cores are not
+     * available to the process.
+     * @param[in] firstCore Core of the first worker. The following workers use the next cores, wrapping around.
+     * @returns true if the workers have been started, otherwise false if running already or an event loop
+     * could not be created.
+     */
+    bool start(uint16_t firstCore = 0U)
+    {
+        bool isStarted = (false == m_isRunning.load(std::memory_order_acquire));
+        long cores     = sysconf(_SC_NPROCESSORS_ONLN);
+
+        for (uint8_t idx = 0U; (idx < tWorkers) && (true == isStarted); idx++)
+        {
+            isStarted = m_workers[idx].m_loop.isValid();
+        }
+
+        if (true == isStarted)
+        {
+            m_isRunning.store(true, std::memory_order_release);
+
+            for (uint8_t idx = 0U; idx < tWorkers; idx++)
+            {
+                Worker& worker = m_workers[idx];
+
+                worker.m_periodStart = worker.m_loop.getTimestamp();
+                worker.m_thread      = std::thread(&SerialMuxProtRuntime::runWorker, this, idx);
+
+                if (0 < cores)
+                {
+                    cpu_set_t coreSet;
+
+                    CPU_ZERO(&coreSet);
+                    CPU_SET(((firstCore + idx) % cores), &coreSet);
+
+                    /* Best effort. Fails e.g. if the core is not in the CPU set of the process. */
+                    (void)pthread_setaffinity_np(worker.m_thread.native_handle(), sizeof(coreSet), &coreSet);
+                }
+            }
+        }
+
+        return isStarted;
+    }
+
+    /**
+     * Stop the worker threads. The links stay assigned to their workers, and are processed again after start().
+     */
+    void stop()
+    {
+        if (true == m_isRunning.exchange(false, std::memory_order_acq_rel))
+        {
+            for (uint8_t idx = 0U; idx < tWorkers; idx++)
+            {
+                m_workers[idx].m_loop.wakeUp();
+            }
+
+            for (uint8_t idx = 0U; idx < tWorkers; idx++)
+            {
+                m_workers[idx].m_thread.join();
+            }
+        }
+    }
+
+    /**
+     * Add a link. It is placed on the worker with the lowest load, or the fewest links at equal load.
+     * @param[in] link Link to add. Its Stream must be opened already.
+     * @returns true if added, otherwise false if the link is known already or the runtime is full.
+     */
+    bool addLink(EventLoopLink* link)
+    {
+        bool    isAdded  = false;
+        uint8_t entryIdx = findEntry(nullptr);
+
+        if ((nullptr != link) && (tMaxLinks == findEntry(link)) && (tMaxLinks > entryIdx))
+        {
+            LinkEntry& entry  = m_entries[entryIdx];
+            uint8_t    target = 0U;
+
+            for (uint8_t idx = 1U; idx < tWorkers; idx++)
+            {
+                uint32_t load       = m_workers[idx].m_load.load(std::memory_order_relaxed);
+                uint32_t targetLoad = m_workers[target].m_load.load(std::memory_order_relaxed);
+
+                if ((load < targetLoad) ||
+                    ((load == targetLoad) && (m_workers[idx].m_numberOfLinks.load(std::memory_order_relaxed) <
+                                              m_workers[target].m_numberOfLinks.load(std::memory_order_relaxed))))
+                {
+                    target = idx;
+                }
+            }
+
+            entry.m_proxy.setLink(link);
+            entry.m_worker.store(target, std::memory_order_relaxed);
+            entry.m_targetWorker.store(target, std::memory_order_relaxed);
+            entry.m_link.store(link, std::memory_order_release);
+            m_workers[target].m_numberOfLinks.fetch_add(1U, std::memory_order_relaxed);
+
+            /* Hand the entry over to the worker. */
+            entry.m_state.store(LINK_PENDING_ADD, std::memory_order_release);
+            signalWorker(target);
+            isAdded = true;
+        }
+
+        return isAdded;
+    }
+
+    /**
+     * Remove a link. Waits until its worker has released it, so the link can be closed afterwards.
+     * @param[in] link Link to remove.
+     * @returns true if removed, otherwise false if the link is unknown.
+     */
+    bool removeLink(EventLoopLink* link)
+    {
+        bool    isRemoved = false;
+        uint8_t entryIdx  = findEntry(link);
+
+        if ((nullptr != link) && (tMaxLinks > entryIdx))
+        {
+            LinkEntry& entry = m_entries[entryIdx];
+            uint8_t    state = entry.m_state.load(std::memory_order_acquire);
+
+            /* The worker changes the state concurrently, e.g. when the link hangs up or is moved. */
+            while ((LINK_FREE != state) && (false == entry.m_state.compare_exchange_weak(state, LINK_PENDING_REMOVE)))
+            {
+                ;
+            }
+
+            if (LINK_FREE == state)
+            {
+                /* Released by the worker already. */
+                ;
+            }
+            else if (true == m_isRunning.load(std::memory_order_acquire))
+            {
+                signalWorker(entry.m_worker.load(std::memory_order_acquire));
+
+                while (LINK_FREE != entry.m_state.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            else
+            {
+                handleCommands(entry.m_worker.load(std::memory_order_acquire));
+            }
+
+            isRemoved = true;
+        }
+
+        return isRemoved;
+    }
+
+    /**
+     * Move a link to another worker. The current worker hands it over after processing its pending events.
+     * @param[in] link Link to move.
+     * @param[in] worker Index of the new worker.
+     * @returns true if the move has been requested, otherwise false if the link or the worker is unknown.
+     */
+    bool moveLink(EventLoopLink* link, uint8_t worker)
+    {
+        bool    isRequested = false;
+        uint8_t entryIdx    = findEntry(link);
+
+        if ((nullptr != link) && (tMaxLinks > entryIdx) && (tWorkers > worker))
+        {
+            LinkEntry& entry = m_entries[entryIdx];
+
+            entry.m_targetWorker.store(worker, std::memory_order_release);
+            signalWorker(entry.m_worker.load(std::memory_order_acquire));
+            isRequested = true;
+        }
+
+        return isRequested;
+    }
+
+    /**
+     * Wake the worker owning a link up, e.g. after frames have been published to the TxSource of its server.
+     * Can be called from any thread, including other workers.
+     * @param[in] link Link to notify.
+     */
+    void notify(const EventLoopLink* link)
+    {
+        uint8_t entryIdx = findEntry(link);
+
+        if ((nullptr != link) && (tMaxLinks > entryIdx))
+        {
+            m_workers[m_entries[entryIdx].m_worker.load(std::memory_order_acquire)].m_loop.wakeUp();
+        }
+    }
+
+    /**
+     * Get the worker owning a link. The owner changes when the link is moved.
+     * @param[in] link Link to look up.
+     * @returns Index of the worker, or UINT8_MAX if the link is unknown.
+     */
+    uint8_t getWorker(const EventLoopLink* link) const
+    {
+        uint8_t worker   = UINT8_MAX;
+        uint8_t entryIdx = findEntry(link);
+
+        if ((nullptr != link) && (tMaxLinks > entryIdx))
+        {
+            worker = m_entries[entryIdx].m_worker.load(std::memory_order_acquire);
+        }
+
+        return worker;
+    }
+
+    /**
+     * Get the number of links of a worker, including links being handed over to it.
+     * @param[in] worker Index of the worker.
+     * @returns Number of links.
+     */
+    uint8_t getNumberOfLinks(uint8_t worker) const
+    {
+        return (tWorkers > worker) ? m_workers[worker].m_numberOfLinks.load(std::memory_order_relaxed) : 0U;
+    }
+
+    /**
+     * Get the load of a worker: the time spent processing links in the last rebalancing period.
+     * @param[in] worker Index of the worker.
+     * @returns Time in microseconds.
+     */
+    uint32_t getLoad(uint8_t worker) const
+    {
+        return (tWorkers > worker) ? m_workers[worker].m_load.load(std::memory_order_relaxed) : 0U;
+    }
+
+    /**
+     * Get the number of links moved between workers, by moveLink() or by rebalancing.
+     * @returns Number of moves.
+     */
+    uint32_t getMigrations() const
+    {
+        return m_migrations.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * States of a link entry.
+     */
+    enum LinkState : uint8_t
+    {
+        LINK_FREE = 0x00,    /**< Entry is not used. */
+        LINK_PENDING_ADD,    /**< Link is waiting to be registered by its worker. */
+        LINK_ACTIVE,         /**< Link is registered with the event loop of its worker. */
+        LINK_PENDING_REMOVE, /**< Link is waiting to be released by its worker. */
+    };
+
+    /**
+     * Proxy registered with the event loop in place of a link. Measures the time spent processing the link.
+     */
+    class LoadMeter : public EventLoopLink
+    {
+    public:
+        /**
+         * Construct the proxy.
+         */
+        LoadMeter() : EventLoopLink(), m_link(nullptr), m_busyTime(0U), m_lastLoad(0U)
+        {
+        }
+
+        /**
+         * Destroy the proxy.
+         */
+        ~LoadMeter()
+        {
+        }
+
+        /**
+         * Set the link to forward to, and reset the measurement.
+         * @param[in] link Link to forward to. nullptr if the entry is free.
+         */
+        void setLink(EventLoopLink* link)
+        {
+            m_link     = link;
+            m_busyTime = 0U;
+            m_lastLoad = 0U;
+        }
+
+        /**
+         * Get the descriptor of the link.
+         * @returns Descriptor, or -1 if closed.
+         */
+        int getFd() const final
+        {
+            return m_link->getFd();
+        }
+
+        /**
+         * Check if the link is still usable.
+         * @returns true if open, otherwise false.
+         */
+        bool isOpen() const final
+        {
+            return m_link->isOpen();
+        }
+
+        /**
+         * Process the link, and add the time spent to the current period.
+         * @param[in] currentTimestamp Time in milliseconds.
+         * @param[in] isReadable Has the descriptor become readable?
+         */
+        void process(uint32_t currentTimestamp, bool isReadable) final
+        {
+            uint64_t startTime = getMicroseconds();
+
+            m_link->process(currentTimestamp, isReadable);
+            m_busyTime += static_cast<uint32_t>(getMicroseconds() - startTime);
+        }
+
+        /**
+         * Mark the link as not usable anymore.
+         */
+        void setHungUp() final
+        {
+            m_link->setHungUp();
+        }
+
+        /**
+         * Get the time until the link has to be processed at the latest.
+         * @param[in] currentTimestamp Time in milliseconds.
+         * @returns Time in milliseconds. 0 if due now.
+         */
+        uint32_t getTimeToNextDeadline(uint32_t currentTimestamp) final
+        {
+            return m_link->getTimeToNextDeadline(currentTimestamp);
+        }
+
+        /**
+         * Check if bytes of the link are waiting for the descriptor to become writable.
+         * @returns true if bytes are pending, otherwise false.
+         */
+        bool isTxPending() const final
+        {
+            return m_link->isTxPending();
+        }
+
+        /**
+         * Finish a measurement period.
+         * @returns Time spent processing the link in the period in microseconds.
+         */
+        uint32_t finishPeriod()
+        {
+            m_lastLoad = m_busyTime;
+            m_busyTime = 0U;
+
+            return m_lastLoad;
+        }
+
+        /**
+         * Get the result of the last measurement period.
+         * @returns Time spent processing the link in microseconds.
+         */
+        uint32_t getLastLoad() const
+        {
+            return m_lastLoad;
+        }
+
+    private:
+        /**
+         * Link to forward to.
+         */
+        EventLoopLink* m_link;
+
+        /**
+         * Time spent processing the link in the current period in microseconds.
+         */
+        uint32_t m_busyTime;
+
+        /**
+         * Time spent processing the link in the last period in microseconds.
+         */
+        uint32_t m_lastLoad;
+
+        /**
+         * Get the time of the monotonic clock.
+         * @returns Time in microseconds.
+         */
+        static uint64_t getMicroseconds()
+        {
+            struct timespec now;
+
+            (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+            return ((static_cast<uint64_t>(now.tv_sec) * 1000000U) + (now.tv_nsec / 1000));
+        }
+
+    private:
+        /* Not allowed. */
+        LoadMeter(const LoadMeter& meter);            /**< Copy Constructor */
+        LoadMeter& operator=(const LoadMeter& meter); /**< Assignment Operator */
+    };
+
+    /**
+     * Link entry. The proxy is only used by the worker owning the entry.
+     */
+    struct LinkEntry
+    {
+        LoadMeter                   m_proxy;        /**< Proxy registered with the event loop. */
+        std::atomic<EventLoopLink*> m_link;         /**< Link of the entry, to look it up. nullptr if free. */
+        std::atomic<uint8_t>        m_state;        /**< State of the entry (LinkState). */
+        std::atomic<uint8_t>        m_worker;       /**< Worker owning the link. */
+        std::atomic<uint8_t>        m_targetWorker; /**< Worker the link shall be moved to. Equals m_worker if none. */
+
+        /**
+         * LinkEntry Constructor.
+         */
+        LinkEntry() : m_proxy(), m_link(nullptr), m_state(LINK_FREE), m_worker(0U), m_targetWorker(0U)
+        {
+        }
+    };
+
+    /**
+     * Worker thread with its event loop. Aligned to cache lines, so workers do not share them.
+     */
+    struct alignas(64) Worker
+    {
+        SerialMuxProtEventLoop<tMaxLinks> m_loop;          /**< Event loop of the worker. */
+        std::thread                       m_thread;        /**< Thread of the worker. */
+        std::atomic<bool>                 m_hasCommands;   /**< Are link entries waiting to be handled? */
+        std::atomic<uint32_t>             m_load;          /**< Load of the last period in microseconds. */
+        std::atomic<uint8_t>              m_numberOfLinks; /**< Number of links, including pending ones. */
+        std::atomic<uint8_t>              m_stealRequest;  /**< Index + 1 of a worker asking for a link. 0 if none. */
+        uint32_t                          m_periodStart;   /**< Start of the measurement period. */
+        uint8_t                           m_activeLinks;   /**< Links registered with the event loop, as last seen. */
+
+        /**
+         * Worker Constructor.
+         */
+        Worker() :
+            m_loop(),
+            m_thread(),
+            m_hasCommands(false),
+            m_load(0U),
+            m_numberOfLinks(0U),
+            m_stealRequest(0U),
+            m_periodStart(0U),
+            m_activeLinks(0U)
+        {
+        }
+    };
+
+    /**
+     * Link entries.
+     */
+    LinkEntry m_entries[tMaxLinks];
+
+    /**
+     * Workers.
+     */
+    Worker m_workers[tWorkers];
+
+    /**
+     * Are the workers running?
+     */
+    std::atomic<bool> m_isRunning;
+
+    /**
+     * Number of links moved between workers.
+     */
+    std::atomic<uint32_t> m_migrations;
+
+    /**
+     * Find the entry of a link.
+     * @param[in] link Link to find. nullptr to find a free entry.
+     * @returns Index of the entry, or tMaxLinks if not found.
+     */
+    uint8_t findEntry(const EventLoopLink* link) const
+    {
+        uint8_t idx = 0U;
+
+        while ((tMaxLinks > idx) &&
+               (((nullptr == link) && (LINK_FREE != m_entries[idx].m_state.load(std::memory_order_acquire))) ||
+                ((nullptr != link) && (link != m_entries[idx].m_link.load(std::memory_order_acquire)))))
+        {
+            idx++;
+        }
+
+        return idx;
+    }
+
+    /**
+     * Tell a worker that link entries are waiting to be handled.
+     * @param[in] worker Index of the worker.
+     */
+    void signalWorker(uint8_t worker)
+    {
+        m_workers[worker].m_hasCommands.store(true, std::memory_order_release);
+        m_workers[worker].m_loop.wakeUp();
+    }
+
+    /**
+     * Main loop of a worker thread.
+     * @param[in] workerIdx Index of the worker.
+     */
+    void runWorker(uint8_t workerIdx)
+    {
+        Worker& worker = m_workers[workerIdx];
+
+        while (true == m_isRunning.load(std::memory_order_acquire))
+        {
+            uint32_t elapsed  = worker.m_loop.getTimestamp() - worker.m_periodStart;
+            uint32_t waitTime = (RUNTIME_REBALANCE_PERIOD > elapsed) ? (RUNTIME_REBALANCE_PERIOD - elapsed) : 0U;
+
+            /* Links released by the event loop after a hang-up are released by the worker, too. */
+            if ((true == worker.m_hasCommands.exchange(false, std::memory_order_acq_rel)) ||
+                (worker.m_activeLinks != worker.m_loop.getNumberOfLinks()))
+            {
+                handleCommands(workerIdx);
+            }
+
+            (void)worker.m_loop.runOnce(waitTime);
+
+            if (RUNTIME_REBALANCE_PERIOD <= (worker.m_loop.getTimestamp() - worker.m_periodStart))
+            {
+                finishPeriod(workerIdx);
+            }
+        }
+    }
+
+    /**
+     * Handle the link entries of a worker: register added links, release removed and hung-up links,
+     * and hand over links to be moved.
+     * @param[in] workerIdx Index of the worker.
+     */
+    void handleCommands(uint8_t workerIdx)
+    {
+        Worker& worker = m_workers[workerIdx];
+        uint8_t thief  = worker.m_stealRequest.exchange(0U, std::memory_order_acq_rel);
+
+        if (0U != thief)
+        {
+            selectLinkToHandOver(workerIdx, (thief - 1U));
+        }
+
+        for (uint8_t idx = 0U; idx < tMaxLinks; idx++)
+        {
+            LinkEntry& entry = m_entries[idx];
+            uint8_t    state = entry.m_state.load(std::memory_order_acquire);
+
+            if ((LINK_FREE != state) && (workerIdx == entry.m_worker.load(std::memory_order_acquire)))
+            {
+                uint8_t target = entry.m_targetWorker.load(std::memory_order_acquire);
+
+                /* Registering fails if the Stream is not open. Changing the state fails if the control thread
+                 * requested the removal meanwhile.
+                 */
+                if ((LINK_PENDING_ADD == state) && (true == worker.m_loop.addLink(&entry.m_proxy)) &&
+                    (true == entry.m_state.compare_exchange_strong(state, LINK_ACTIVE)))
+                {
+                    state = LINK_ACTIVE;
+                }
+
+                if ((LINK_ACTIVE != state) || (false == entry.m_proxy.isOpen()))
+                {
+                    /* Removed, hung up, or the Stream has not been open when added. */
+                    releaseEntry(workerIdx, entry);
+                }
+                else if ((workerIdx != target) && (tWorkers > target) &&
+                         (true == entry.m_state.compare_exchange_strong(state, LINK_PENDING_ADD)))
+                {
+                    /* Hand the link over. The new worker registers it. */
+                    (void)worker.m_loop.removeLink(&entry.m_proxy);
+                    worker.m_numberOfLinks.fetch_sub(1U, std::memory_order_relaxed);
+                    m_workers[target].m_numberOfLinks.fetch_add(1U, std::memory_order_relaxed);
+                    entry.m_worker.store(target, std::memory_order_release);
+                    m_migrations.fetch_add(1U, std::memory_order_relaxed);
+                    signalWorker(target);
+                }
+                else
+                {
+                    /* Nothing to do. */
+                    ;
+                }
+            }
+        }
+
+        worker.m_activeLinks = worker.m_loop.getNumberOfLinks();
+    }
+
+    /**
+     * Release the entry of a link.
+     * @param[in] workerIdx Index of the worker owning the entry.
+     * @param[in] entry Entry to release.
+     */
+    void releaseEntry(uint8_t workerIdx, LinkEntry& entry)
+    {
+        Worker& worker = m_workers[workerIdx];
+
+        /* Fails if the link is not registered, e.g. the event loop has released it after a hang-up already. */
+        (void)worker.m_loop.removeLink(&entry.m_proxy);
+        worker.m_numberOfLinks.fetch_sub(1U, std::memory_order_relaxed);
+        entry.m_link.store(nullptr, std::memory_order_relaxed);
+        entry.m_state.store(LINK_FREE, std::memory_order_release);
+    }
+
+    /**
+     * Finish the measurement period of a worker: publish its load, and ask the busiest worker for a link,
+     * if it has much more load.
+     * @param[in] workerIdx Index of the worker.
+     */
+    void finishPeriod(uint8_t workerIdx)
+    {
+        Worker&  worker  = m_workers[workerIdx];
+        uint32_t load    = 0U;
+        uint8_t  busiest = workerIdx;
+
+        for (uint8_t idx = 0U; idx < tMaxLinks; idx++)
+        {
+            LinkEntry& entry = m_entries[idx];
+
+            if ((LINK_ACTIVE == entry.m_state.load(std::memory_order_acquire)) &&
+                (workerIdx == entry.m_worker.load(std::memory_order_relaxed)))
+            {
+                load += entry.m_proxy.finishPeriod();
+            }
+        }
+
+        worker.m_load.store(load, std::memory_order_relaxed);
+        worker.m_periodStart = worker.m_loop.getTimestamp();
+
+        for (uint8_t idx = 0U; idx < tWorkers; idx++)
+        {
+            if (m_workers[idx].m_load.load(std::memory_order_relaxed) >
+                m_workers[busiest].m_load.load(std::memory_order_relaxed))
+            {
+                busiest = idx;
+            }
+        }
+
+        if ((busiest != workerIdx) && (1U < m_workers[busiest].m_numberOfLinks.load(std::memory_order_relaxed)) &&
+            ((m_workers[busiest].m_load.load(std::memory_order_relaxed) - load) > RUNTIME_REBALANCE_MIN_LOAD))
+        {
+            uint8_t noRequest = 0U;
+
+            if (true == m_workers[busiest].m_stealRequest.compare_exchange_strong(noRequest, (workerIdx + 1U)))
+            {
+                signalWorker(busiest);
+            }
+        }
+    }
+
+    /**
+     * Select the link to hand over to a worker asking for one: the link which brings the loads of both workers
+     * closest together. No link is handed over, if none reduces the load difference.
+     * @param[in] workerIdx Index of the worker owning the links.
+     * @param[in] thief Index of the worker asking for a link.
+     */
+    void selectLinkToHandOver(uint8_t workerIdx, uint8_t thief)
+    {
+        uint32_t load       = m_workers[workerIdx].m_load.load(std::memory_order_relaxed);
+        uint32_t thiefLoad  = m_workers[thief].m_load.load(std::memory_order_relaxed);
+        uint32_t difference = (load > thiefLoad) ? (load - thiefLoad) : 0U;
+        uint8_t  selected   = tMaxLinks;
+
+        for (uint8_t idx = 0U; idx < tMaxLinks; idx++)
+        {
+            LinkEntry& entry = m_entries[idx];
+
+            if ((LINK_ACTIVE == entry.m_state.load(std::memory_order_acquire)) &&
+                (workerIdx == entry.m_worker.load(std::memory_order_relaxed)))
+            {
+                /* Load difference after moving the link. */
+                uint32_t linkLoad = 2U * entry.m_proxy.getLastLoad();
+                uint32_t newDifference =
+                    (difference > linkLoad) ? (difference - linkLoad) : (linkLoad - difference);
+
+                if (newDifference < difference)
+                {
+                    difference = newDifference;
+                    selected   = idx;
+                }
+            }
+        }
+
+        if (tMaxLinks > selected)
+        {
+            m_entries[selected].m_targetWorker.store(thief, std::memory_order_release);
+        }
+    }
+
+private:
+    /* Not allowed. */
+    SerialMuxProtRuntime(const SerialMuxProtRuntime& runtime);            /**< Copy Constructor */
+    SerialMuxProtRuntime& operator=(const SerialMuxProtRuntime& runtime); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_RUNTIME_H */
+/** @} */
@@ -0,0 +1,340 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  RX Buffers of the SerialMuxProt Server.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_RX_BUFFER_H
+#define SERIALMUXPROT_RX_BUFFER_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <Stream.h>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Ring buffer for received bytes.
+ * It is filled with bulk reads of everything available in the Stream,
+ * so frames can be parsed without further calls to the Stream.
+ *
+ * @tparam tSize Size of the ring buffer in bytes. Must be able to hold at least one frame.
+ * @tparam tMaxFrameLen Maximum length of a frame in bytes.
+ */
+template<uint16_t tSize, uint16_t tMaxFrameLen>
+class SerialMuxProtRxBuffer
+{
+public:
+    static_assert(tSize >= tMaxFrameLen, "RX buffer must be able to hold at least one frame.");
+
+    /**
+     * Construct the RX ring buffer.
+     */
+    SerialMuxProtRxBuffer() : m_storage{0U}, m_staging{0U}, m_readIdx(0U), m_count(0U)
+    {
+    }
+
+    /**
+     * Destroy the RX ring buffer.
+     */
+    ~SerialMuxProtRxBuffer()
+    {
+    }
+
+    /**
+     * Read everything available in the Stream, as long as there is free space in the buffer.
+     * @tparam tSource Type of the source, either a Stream or a RxSource.
+     * @param[in] stream Stream to read from.
+     * @param[in] requiredBytes Number of bytes the parser is waiting for. Not used, as all available bytes are read.
+     * @param[in] maxBytes Maximum number of bytes allowed to be read.
+     * @returns Number of bytes read from the Stream.
+     */
+    template<typename tSource>
+    uint32_t fill(tSource& stream, uint16_t requiredBytes, uint32_t maxBytes)
+    {
+        uint32_t readBytes      = 0U;
+        int      availableBytes = stream.available();
+
+        (void)requiredBytes;
+
+        if (0 < availableBytes)
+        {
+            uint32_t toRead = static_cast<uint32_t>(availableBytes);
+
+            if (static_cast<uint32_t>(tSize - m_count) < toRead)
+            {
+                toRead = static_cast<uint32_t>(tSize - m_count);
+            }
+
+            if (maxBytes < toRead)
+            {
+                toRead = maxBytes;
+            }
+
+            while (0U != toRead)
+            {
+                uint16_t writeIdx  = (m_readIdx + m_count) % tSize;
+                uint16_t chunkSize = tSize - writeIdx;
+                size_t   chunkRead = 0U;
+
+                if (toRead < chunkSize)
+                {
+                    chunkSize = static_cast<uint16_t>(toRead);
+                }
+
+                chunkRead = stream.readBytes(&m_storage[writeIdx], chunkSize);
+                m_count += static_cast<uint16_t>(chunkRead);
+                readBytes += chunkRead;
+
+                if (chunkSize != chunkRead)
+                {
+                    /* Stream delivered less than announced. */
+                    break;
+                }
+
+                toRead -= chunkSize;
+            }
+        }
+
+        return readBytes;
+    }
+
+    /**
+     * Get the number of buffered bytes.
+     * @returns Number of bytes in the buffer.
+     */
+    uint16_t size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get a buffered byte without removing it.
+     * @param[in] offset Offset from the oldest buffered byte. Must be smaller than size().
+     * @returns Value of the byte.
+     */
+    uint8_t peek(uint16_t offset) const
+    {
+        return m_storage[(m_readIdx + offset) % tSize];
+    }
+
+    /**
+     * Get the oldest buffered bytes as a contiguous frame.
+     * If the frame is contiguous in the storage, a pointer into the storage is returned without copying.
+     * Only a frame wrapping around the end of the storage is copied into the staging buffer.
+     * @param[in] length Length of the frame. Must not be greater than size() and tMaxFrameLen.
+     * @returns Pointer to the frame. Valid until the buffer is modified.
+     */
+    const uint8_t* getFrame(uint16_t length)
+    {
+        const uint8_t* frame      = &m_storage[m_readIdx];
+        uint16_t       firstChunk = tSize - m_readIdx;
+
+        if (length > firstChunk)
+        {
+            memcpy(m_staging, &m_storage[m_readIdx], firstChunk);
+            memcpy(&m_staging[firstChunk], m_storage, (length - firstChunk));
+            frame = m_staging;
+        }
+
+        return frame;
+    }
+
+    /**
+     * Remove the oldest buffered bytes.
+     * @param[in] count Number of bytes to remove.
+     */
+    void discard(uint16_t count)
+    {
+        if (m_count < count)
+        {
+            count = m_count;
+        }
+
+        m_readIdx = (m_readIdx + count) % tSize;
+        m_count -= count;
+    }
+
+private:
+    /**
+     * Ring buffer storage.
+     */
+    uint8_t m_storage[tSize];
+
+    /**
+     * Staging buffer for frames wrapping around the end of the storage.
+     */
+    uint8_t m_staging[tMaxFrameLen];
+
+    /**
+     * Index of the oldest buffered byte.
+     */
+    uint16_t m_readIdx;
+
+    /**
+     * Number of buffered bytes.
+     */
+    uint16_t m_count;
+
+private:
+    /* Not allowed. */
+    SerialMuxProtRxBuffer(const SerialMuxProtRxBuffer& buffer);            /**< Copy Constructor */
+    SerialMuxProtRxBuffer& operator=(const SerialMuxProtRxBuffer& buffer); /**< Assignment Operator */
+};
+
+/**
+ * RX window without internal buffering.
+ * Only the bytes required by the parser are read from the Stream, and only if all of them are available.
+ *
+ * @tparam tMaxFrameLen Maximum length of a frame in bytes.
+ */
+template<uint16_t tMaxFrameLen>
+class SerialMuxProtRxBuffer<0U, tMaxFrameLen>
+{
+public:
+    /**
+     * Construct the RX window.
+     */
+    SerialMuxProtRxBuffer() : m_window{0U}, m_count(0U)
+    {
+    }
+
+    /**
+     * Destroy the RX window.
+     */
+    ~SerialMuxProtRxBuffer()
+    {
+    }
+
+    /**
+     * Read the required bytes from the Stream, if all of them are available.
+     * @tparam tSource Type of the source, either a Stream or a RxSource.
+     * @param[in] stream Stream to read from.
+     * @param[in] requiredBytes Number of bytes the parser is waiting for.
+     * @param[in] maxBytes Maximum number of bytes allowed to be read.
+     * @returns Number of bytes read from the Stream.
+     */
+    template<typename tSource>
+    uint32_t fill(tSource& stream, uint16_t requiredBytes, uint32_t maxBytes)
+    {
+        uint32_t readBytes = 0U;
+
+        if ((requiredBytes <= maxBytes) && (requiredBytes <= (tMaxFrameLen - m_count)) &&
+            (static_cast<int>(requiredBytes) <= stream.available()))
+        {
+            readBytes = stream.readBytes(&m_window[m_count], requiredBytes);
+            m_count += static_cast<uint16_t>(readBytes);
+        }
+
+        return readBytes;
+    }
+
+    /**
+     * Get the number of buffered bytes.
+     * @returns Number of bytes in the window.
+     */
+    uint16_t size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get a buffered byte without removing it.
+     * @param[in] offset Offset from the oldest buffered byte. Must be smaller than size().
+     * @returns Value of the byte.
+     */
+    uint8_t peek(uint16_t offset) const
+    {
+        return m_window[offset];
+    }
+
+    /**
+     * Get the oldest buffered bytes as a contiguous frame.
+     * @param[in] length Length of the frame. Must not be greater than size().
+     * @returns Pointer to the frame. Valid until the window is modified.
+     */
+    const uint8_t* getFrame(uint16_t length)
+    {
+        (void)length;
+        return m_window;
+    }
+
+    /**
+     * Remove the oldest buffered bytes.
+     * @param[in] count Number of bytes to remove.
+     */
+    void discard(uint16_t count)
+    {
+        if (m_count < count)
+        {
+            count = m_count;
+        }
+
+        m_count -= count;
+
+        if (0U != m_count)
+        {
+            memmove(&m_window[0U], &m_window[count], m_count);
+        }
+    }
+
+private:
+    /**
+     * Window of received bytes.
+     */
+    uint8_t m_window[tMaxFrameLen];
+
+    /**
+     * Number of bytes in the window.
+     */
+    uint16_t m_count;
+
+private:
+    /* Not allowed. */
+    SerialMuxProtRxBuffer(const SerialMuxProtRxBuffer& buffer);            /**< Copy Constructor */
+    SerialMuxProtRxBuffer& operator=(const SerialMuxProtRxBuffer& buffer); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_RX_BUFFER_H */
+/** @} */
@@ -0,0 +1,487 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Segmented messages of SerialMuxProt.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * A segmented message is split across consecutive frames of a channel.
+ * Each frame starts with a segment header, followed by a chunk of the message:
+ * - Message ID (1 Byte): Identifies the message. Incremented for every message.
+ * - Fragment Index (2 Bytes, little endian): Index of the fragment in the message, starting at 0.
+ * - Message Length (2 Bytes, little endian): Length of the complete message.
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_SEGMENTATION_H
+#define SERIALMUXPROT_SEGMENTATION_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/** Length of the segment header in Bytes. */
+#define SEGMENT_HEADER_LEN (5U)
+
+/** Index of the Message ID in the segment header. */
+#define SEGMENT_MESSAGE_ID_IDX (0U)
+
+/** Index of the Fragment Index in the segment header. */
+#define SEGMENT_FRAGMENT_IDX (1U)
+
+/** Index of the Message Length in the segment header. */
+#define SEGMENT_LENGTH_IDX (3U)
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Message Notification Prototype Callback.
+ * Provides a completely reassembled message to the application.
+ *
+ * @param[in] message       Reassembled message, in the buffer of the receiver.
+ * @param[in] messageSize   Size of the message.
+ * @param[in] userData      User data provided by the application.
+ */
+typedef void (*MessageCallback)(const uint8_t* message, uint16_t messageSize, void* userData);
+
+/**
+ * Sender of segmented messages on a TX channel.
+ * Only one fragment is sent per call to process(), so frames of other channels can be sent in between.
+ *
+ * Example:
+ * @code
+ * gCalibrationSender.create(gSmpServer, "CALIB", 32U);
+ * gCalibrationSender.send(calibrationTable, sizeof(calibrationTable));
+ *
+ * // Cyclic
+ * gCalibrationSender.process(gSmpServer);
+ * @endcode
+ */
+class SegmentSender
+{
+public:
+    /**
+     * Construct the segment sender.
+     */
+    SegmentSender() :
+        m_channelNumber(0U),
+        m_dlc(0U),
+        m_message(nullptr),
+        m_messageLength(0U),
+        m_sentBytes(0U),
+        m_fragmentIndex(0U),
+        m_messageId(0U)
+    {
+    }
+
+    /**
+     * Destroy the segment sender.
+     */
+    ~SegmentSender()
+    {
+    }
+
+    /**
+     * Create the TX channel on the server.
+     * @tparam tServer Type of the SerialMuxProt Server.
+     * @param[in] server Server to create the channel on.
+     * @param[in] channelName Name of the channel.
+     * @param[in] dlc Length of the payload of the channel. Must be greater than SEGMENT_HEADER_LEN.
+     * @returns true if the channel has been created, otherwise false.
+     */
+    template<typename tServer>
+    bool create(tServer& server, const char* channelName, uint8_t dlc)
+    {
+        if (SEGMENT_HEADER_LEN < dlc)
+        {
+            m_channelNumber = server.createChannel(channelName, dlc);
+            m_dlc           = dlc;
+        }
+
+        return (0U != m_channelNumber);
+    }
+
+    /**
+     * Start sending a message.
+     * The message is not copied. It must remain valid until the sender is no longer busy.
+     * @param[in] message Message to send.
+     * @param[in] messageLength Length of the message.
+     * @returns true if the message has been accepted, otherwise false if busy or invalid.
+     */
+    bool send(const void* message, uint16_t messageLength)
+    {
+        bool isAccepted = false;
+
+        if ((0U != m_channelNumber) && (false == isBusy()) && (nullptr != message) && (0U != messageLength))
+        {
+            m_message       = static_cast<const uint8_t*>(message);
+            m_messageLength = messageLength;
+            m_sentBytes     = 0U;
+            m_fragmentIndex = 0U;
+            m_messageId++;
+            isAccepted = true;
+        }
+
+        return isAccepted;
+    }
+
+    /**
+     * Send the next fragment of the current message.
+     * Call this function cyclic. A fragment not accepted by the server is sent again on the next call.
+     * @tparam tServer Type of the SerialMuxProt Server.
+     * @param[in] server Server the channel has been created on.
+     * @returns true if a fragment has been sent, otherwise false.
+     */
+    template<typename tServer>
+    bool process(tServer& server)
+    {
+        bool     isSent  = false;
+        uint8_t* payload = nullptr;
+
+        if (true == isBusy())
+        {
+            payload = server.claim(m_channelNumber);
+        }
+
+        if (nullptr != payload)
+        {
+            uint16_t chunkSize = m_dlc - SEGMENT_HEADER_LEN;
+
+            if ((m_messageLength - m_sentBytes) < chunkSize)
+            {
+                /* Last fragment is shorter. */
+                chunkSize = (m_messageLength - m_sentBytes);
+            }
+
+            payload[SEGMENT_MESSAGE_ID_IDX]    = m_messageId;
+            payload[SEGMENT_FRAGMENT_IDX]      = static_cast<uint8_t>(m_fragmentIndex & 0xFFU);
+            payload[SEGMENT_FRAGMENT_IDX + 1U] = static_cast<uint8_t>(m_fragmentIndex >> 8U);
+            payload[SEGMENT_LENGTH_IDX]        = static_cast<uint8_t>(m_messageLength & 0xFFU);
+            payload[SEGMENT_LENGTH_IDX + 1U]   = static_cast<uint8_t>(m_messageLength >> 8U);
+            memcpy(&payload[SEGMENT_HEADER_LEN], &m_message[m_sentBytes], chunkSize);
+
+            if (true == server.commit(static_cast<uint8_t>(SEGMENT_HEADER_LEN + chunkSize)))
+            {
+                m_sentBytes += chunkSize;
+                m_fragmentIndex++;
+                isSent = true;
+            }
+        }
+
+        return isSent;
+    }
+
+    /**
+     * Cancel the current message. The receiver drops it on the next message.
+     */
+    void cancel()
+    {
+        m_message       = nullptr;
+        m_messageLength = 0U;
+        m_sentBytes     = 0U;
+    }
+
+    /**
+     * Check if a message is being sent.
+     * @returns true if fragments of the current message are pending, otherwise false.
+     */
+    bool isBusy() const
+    {
+        return (m_sentBytes < m_messageLength);
+    }
+
+    /**
+     * Get the number of the TX channel.
+     * @returns Number of the channel, or 0 if not created.
+     */
+    uint8_t getChannelNumber() const
+    {
+        return m_channelNumber;
+    }
+
+private:
+    /**
+     * Number of the TX channel.
+     */
+    uint8_t m_channelNumber;
+
+    /**
+     * DLC of the TX channel.
+     */
+    uint8_t m_dlc;
+
+    /**
+     * Message being sent.
+     */
+    const uint8_t* m_message;
+
+    /**
+     * Length of the message being sent.
+     */
+    uint16_t m_messageLength;
+
+    /**
+     * Number of bytes of the message already sent.
+     */
+    uint16_t m_sentBytes;
+
+    /**
+     * Index of the next fragment.
+     */
+    uint16_t m_fragmentIndex;
+
+    /**
+     * ID of the current message.
+     */
+    uint8_t m_messageId;
+
+private:
+    /* Not allowed. */
+    SegmentSender(const SegmentSender& sender);            /**< Copy Constructor */
+    SegmentSender& operator=(const SegmentSender& sender); /**< Assignment Operator */
+};
+
+/**
+ * Receiver of segmented messages on a RX channel.
+ * The fragments are reassembled into a buffer provided by the application.
+ * The callback is called once per complete message. A message with a missing fragment is dropped.
+ *
+ * Example:
+ * @code
+ * void onCalibrationChannel(const uint8_t* payload, uint8_t payloadSize, void* userData)
+ * {
+ *     gCalibrationReceiver.receive(payload, payloadSize);
+ * }
+ *
+ * gSmpServer.subscribeToChannel("CALIB", onCalibrationChannel);
+ * @endcode
+ */
+class SegmentReceiver
+{
+public:
+    /**
+     * Construct the segment receiver.
+     * @param[in] buffer Buffer to reassemble messages into.
+     * @param[in] bufferSize Size of the buffer. Longer messages are dropped.
+     * @param[in] callback Callback to provide the reassembled messages.
+     * @param[in] userData User data to be passed to the callback.
+     */
+    SegmentReceiver(uint8_t* buffer, uint16_t bufferSize, MessageCallback callback, void* userData) :
+        m_buffer(buffer),
+        m_bufferSize(bufferSize),
+        m_callback(callback),
+        m_userData(userData),
+        m_isReceiving(false),
+        m_messageId(0U),
+        m_messageLength(0U),
+        m_receivedBytes(0U),
+        m_nextFragmentIndex(0U),
+        m_droppedMessages(0U)
+    {
+    }
+
+    /**
+     * Destroy the segment receiver.
+     */
+    ~SegmentReceiver()
+    {
+    }
+
+    /**
+     * Process a received fragment. Call this function from the callback of the channel.
+     * @param[in] payload Received payload.
+     * @param[in] payloadSize Size of the received payload.
+     * @returns true if the fragment completed a message, otherwise false.
+     */
+    bool receive(const uint8_t* payload, uint8_t payloadSize)
+    {
+        bool isComplete = false;
+
+        if ((nullptr != payload) && (SEGMENT_HEADER_LEN < payloadSize))
+        {
+            uint8_t  messageId     = payload[SEGMENT_MESSAGE_ID_IDX];
+            uint16_t fragmentIndex = static_cast<uint16_t>(payload[SEGMENT_FRAGMENT_IDX]) |
+                                     static_cast<uint16_t>(payload[SEGMENT_FRAGMENT_IDX + 1U] << 8U);
+            uint16_t messageLength = static_cast<uint16_t>(payload[SEGMENT_LENGTH_IDX]) |
+                                     static_cast<uint16_t>(payload[SEGMENT_LENGTH_IDX + 1U] << 8U);
+
+            if (0U == fragmentIndex)
+            {
+                startMessage(messageId, messageLength);
+            }
+
+            if ((true == m_isReceiving) && (messageId == m_messageId) && (fragmentIndex == m_nextFragmentIndex) &&
+                (messageLength == m_messageLength))
+            {
+                uint16_t chunkSize = payloadSize - SEGMENT_HEADER_LEN;
+
+                if ((m_messageLength - m_receivedBytes) < chunkSize)
+                {
+                    /* Ignore padding of the last fragment. */
+                    chunkSize = (m_messageLength - m_receivedBytes);
+                }
+
+                memcpy(&m_buffer[m_receivedBytes], &payload[SEGMENT_HEADER_LEN], chunkSize);
+                m_receivedBytes += chunkSize;
+                m_nextFragmentIndex++;
+
+                if (m_messageLength == m_receivedBytes)
+                {
+                    m_isReceiving = false;
+                    isComplete    = true;
+
+                    if (nullptr != m_callback)
+                    {
+                        m_callback(m_buffer, m_messageLength, m_userData);
+                    }
+                }
+            }
+            else if (true == m_isReceiving)
+            {
+                /* Fragment is missing or out of order. */
+                m_isReceiving = false;
+                m_droppedMessages++;
+            }
+            else
+            {
+                /* Not receiving. Wait for the next message. */
+                ;
+            }
+        }
+
+        return isComplete;
+    }
+
+    /**
+     * Get the number of dropped messages.
+     * @returns Number of messages dropped because of missing fragments or insufficient buffer size.
+     */
+    uint32_t getDroppedMessages() const
+    {
+        return m_droppedMessages;
+    }
+
+private:
+    /**
+     * Start reassembling a message. A message still being received is dropped.
+     * @param[in] messageId ID of the message.
+     * @param[in] messageLength Length of the message.
+     */
+    void startMessage(uint8_t messageId, uint16_t messageLength)
+    {
+        if (true == m_isReceiving)
+        {
+            m_droppedMessages++;
+        }
+
+        if ((nullptr != m_buffer) && (0U != messageLength) && (m_bufferSize >= messageLength))
+        {
+            m_isReceiving       = true;
+            m_messageId         = messageId;
+            m_messageLength     = messageLength;
+            m_receivedBytes     = 0U;
+            m_nextFragmentIndex = 0U;
+        }
+        else
+        {
+            m_isReceiving = false;
+            m_droppedMessages++;
+        }
+    }
+
+    /**
+     * Buffer to reassemble messages into.
+     */
+    uint8_t* m_buffer;
+
+    /**
+     * Size of the buffer.
+     */
+    uint16_t m_bufferSize;
+
+    /**
+     * Callback to provide the reassembled messages.
+     */
+    MessageCallback m_callback;
+
+    /**
+     * User data to be passed to the callback.
+     */
+    void* m_userData;
+
+    /**
+     * A message is being reassembled.
+     */
+    bool m_isReceiving;
+
+    /**
+     * ID of the message being reassembled.
+     */
+    uint8_t m_messageId;
+
+    /**
+     * Length of the message being reassembled.
+     */
+    uint16_t m_messageLength;
+
+    /**
+     * Number of bytes of the message received.
+     */
+    uint16_t m_receivedBytes;
+
+    /**
+     * Index of the next expected fragment.
+     */
+    uint16_t m_nextFragmentIndex;
+
+    /**
+     * Number of dropped messages.
+     */
+    uint32_t m_droppedMessages;
+
+private:
+    /* Not allowed. */
+    SegmentReceiver();                                           /**< Default Constructor */
+    SegmentReceiver(const SegmentReceiver& receiver);            /**< Copy Constructor */
+    SegmentReceiver& operator=(const SegmentReceiver& receiver); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_SEGMENTATION_H */
+/** @} */
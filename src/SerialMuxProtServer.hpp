@@ -43,6 +43,10 @@
  *****************************************************************************/
 
 #include <SerialMuxProtCommon.hpp>
+#include <SerialMuxProtIntegrity.hpp>
+#include <SerialMuxProtRateLimit.hpp>
+#include <SerialMuxProtRxBuffer.hpp>
+#include <SerialMuxProtTxBuffer.hpp>
 #include <Stream.h>
 #include <string.h>
 
@@ -57,11 +61,29 @@
 /**
  * Class for the SerialMuxProt Server.
  * @tparam tMaxChannels Maximum number of channels
+ * @tparam tRxBufferSize Size of the internal RX ring buffer in bytes.
+ * If 0, no ring buffer is used and only the bytes of the current frame are read from the Stream.
+ * @tparam tIntegrity Frame integrity policy, see SerialMuxProtIntegrity.hpp. Both peers must use the same policy.
+ * @tparam tTxBufferSize Size of the internal TX staging buffer in bytes.
+ * If 0, no staging buffer is used and every frame is written directly to the Stream.
+ * @tparam tMaxDataLen Maximum payload length of a frame in bytes. Both peers must use the same value.
  */
-template<uint8_t tMaxChannels>
+template<uint8_t tMaxChannels, uint16_t tRxBufferSize = 0U, typename tIntegrity = SumChecksum,
+         uint16_t tTxBufferSize = 0U, uint8_t tMaxDataLen = MAX_DATA_LEN>
 class SerialMuxProtServer
 {
 public:
+    static_assert(CONTROL_CHANNEL_PAYLOAD_LENGTH <= tMaxDataLen, "Payload must hold a control channel payload.");
+
+    /** Maximum payload length of a frame. */
+    static const uint8_t MAX_PAYLOAD_LEN = tMaxDataLen;
+
+    /** Length of the frame header, depending on the integrity policy. */
+    static const uint8_t FRAME_HEADER_LEN = CHANNEL_LEN + DLC_LEN + tIntegrity::LENGTH;
+
+    /** Maximum length of a frame, depending on the integrity policy and the maximum payload length. */
+    static const uint16_t FRAME_MAX_LEN = FRAME_HEADER_LEN + tMaxDataLen;
+
     /**
      * Construct the SerialMuxProt Server.
      *
@@ -80,17 +102,48 @@ public:
      * @param[in] userData User object to be passed to the callbacks.
      */
     SerialMuxProtServer(Stream& stream, void* userData) :
-        m_rxCallbacks{nullptr},
+        m_rxChannels(),
         m_isSynced(false),
         m_lastSyncCommand(0U),
         m_lastSyncResponse(0U),
+        m_remoteMaxDataLength(0U),
         m_stream(stream),
-        m_receiveFrame(),
-        m_receivedBytes(0U),
+        m_rxSource(nullptr),
+        m_rxBuffer(),
         m_rxAttempts(0U),
+        m_rxResyncDiscardedBytes(0U),
+        m_rxStatistics(),
+        m_txBuffer(),
+        m_isTxBatchActive(false),
+        m_isProcessing(false),
+        m_claimedFrame(nullptr),
+        m_vectoredWriter(nullptr),
+        m_isTxBackPressureEnabled(false),
+        m_isSuperFrameEnabled(false),
+        m_superFrame(nullptr),
+        m_superFrameRecords(0U),
+        m_superFramePriority(TX_PRIORITY_NORMAL),
+        m_isTxSubscriptionFilterEnabled(false),
+        m_remoteSubscriptions{0U},
+        m_conflatedChannels{0U},
+        m_pendingConflatedFrames{0U},
+        m_conflatedFramePositions{0U},
+        m_txRateLimits{nullptr},
+        m_txSource(nullptr),
+        m_txClassTails{0U},
+        m_txClassPendingSince{0U},
+        m_pendingTxClasses(0U),
+        m_txLockedEnd(0U),
+        m_lastQueuedFramePosition(0U),
+        m_txStatistics(),
+        m_txFlushThreshold(tTxBufferSize),
+        m_txFlushPeriod(0U),
+        m_txPendingSince(0U),
+        m_currentTimestamp(0U),
         m_numberOfTxChannels(0U),
         m_numberOfRxChannels(0U),
         m_numberOfPendingChannels(0U),
+        m_lastGeneration(0U),
         m_userData(userData),
         m_onSynced(nullptr),
         m_onDeSynced(nullptr)
@@ -111,295 +164,1607 @@ public:
      */
     void process(const uint32_t currentTimestamp)
     {
-        /* Periodic Heartbeat */
-        heartbeat(currentTimestamp);
-
-        /* Process RX data */
-        processRxData();
+        (void)process(currentTimestamp, 1U, UINT32_MAX);
     }
 
     /**
-     * Send a frame with the selected bytes.
-     * @param[in] channelNumber Channel to send frame to.
-     * @param[in] payload Byte buffer to be sent.
-     * @param[in] payloadSize Amount of bytes to send.
-     * @returns If payload succesfully sent, returns true. Otherwise, false.
+     * Manage the Server functions, processing all complete frames available in the Stream.
+     * Call this function cyclic.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @param[in] maxFrames Maximum number of frames to process in this call.
+     * @param[in] maxBytes Maximum number of bytes to read from the Stream in this call.
+     * Without RX buffer, the header and the payload of a frame are only read if they fit in the remaining byte
+     * budget. With RX buffer, the available bytes are read in bulk up to the remaining byte budget, which may end
+     * within a frame. The rest of that frame is read by a later call.
+     * @returns Number of dispatched frames and number of bytes still pending in the Stream and the RX buffer.
      */
-    bool sendData(uint8_t channelNumber, const void* payload, uint8_t payloadSize) const
+    RxDrainResult process(const uint32_t currentTimestamp, uint16_t maxFrames, uint32_t maxBytes)
     {
-        bool isSent = false;
+        RxDrainResult result;
 
-        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (nullptr != payload) && (true == m_isSynced))
+        m_currentTimestamp = currentTimestamp;
+
+        /* Frames sent during processing are written together at the end. */
+        m_isProcessing = true;
+
+        /* Periodic Heartbeat */
+        heartbeat(currentTimestamp);
+
+        /* Process RX data */
+        result = processRxData(maxFrames, maxBytes);
+
+        /* Send frames held back by rate limits. */
+        sendDeferredFrames();
+
+        /* Send frames published by other threads. */
+        sendTxSourceFrames();
+
+        m_isProcessing = false;
+
+        if ((false == m_isTxBatchActive) ||
+            ((0U != m_txFlushPeriod) && ((currentTimestamp - m_txPendingSince) >= m_txFlushPeriod)))
         {
-            isSent = send(channelNumber, payload, payloadSize);
+            (void)flushTxBuffer();
         }
 
-        return isSent;
+        return result;
     }
 
     /**
-     * Send a frame with the selected bytes.
-     * @param[in] channelName Channel to send frame to.
-     * @param[in] payload Byte buffer to be sent.
-     * @param[in] payloadSize Amount of bytes to send.
-     * @returns If payload succesfully sent, returns true. Otherwise, false.
+     * Begin a batch of frames.
+     * Frames sent until flush() is called are collected in the TX staging buffer and written together.
+     * The size and time thresholds still apply. Without TX staging buffer, frames are written directly.
      */
-    bool sendData(const char* channelName, const uint8_t* payload, uint8_t payloadSize) const
+    void beginBatch()
     {
-        bool isSent = false;
+        m_isTxBatchActive = (0U != tTxBufferSize);
+    }
 
-        if (nullptr != channelName)
-        {
-            isSent = sendData(getTxChannelNumber(channelName), payload, payloadSize);
-        }
+    /**
+     * End the current batch, if any, and write all frames in the TX staging buffer to the Stream.
+     * @returns true if all frames have been written, otherwise false. The remainder is written on the next flush.
+     */
+    bool flush()
+    {
+        m_isTxBatchActive = false;
 
-        return isSent;
+        return flushTxBuffer();
     }
 
     /**
-     * Get Number of a TX channel by its name.
-     * @param[in] channelName Name of Channel
-     * @returns Number of the Channel, or 0 if not channel with the name is present.
+     * Get the time until process() has to be called at the latest, if no bytes are received meanwhile.
+     * Considers the heartbeat, the time threshold of an active batch, frames deferred by rate limits and
+     * pending frames of the TxSource. An event loop can sleep this long, instead of calling process() cyclic.
+     * While the TX path is blocked, i.e. bytes are pending or a frame is claimed, deferred and TxSource frames
+     * are not due, as they could not be sent anyway. The event loop is woken by the Stream becoming writable then.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @returns Time in milliseconds. 0 if process() is due now.
      */
-    uint8_t getTxChannelNumber(const char* channelName) const
+    uint32_t getTimeToNextDeadline(const uint32_t currentTimestamp)
     {
-        uint8_t idx = tMaxChannels;
+        uint32_t heartbeatPeriod = (true == m_isSynced) ? HEATBEAT_PERIOD_SYNCED : HEATBEAT_PERIOD_UNSYNCED;
+        uint32_t waitTime        = getRemainingTime(currentTimestamp, m_lastSyncCommand, heartbeatPeriod);
 
-        if (nullptr != channelName)
+        if ((true == m_isTxBatchActive) && (0U != m_txFlushPeriod) && (0U != m_txBuffer.size()))
         {
-            for (idx = 0U; idx < tMaxChannels; idx++)
+            uint32_t flushTime = getRemainingTime(currentTimestamp, m_txPendingSince, m_txFlushPeriod);
+
+            waitTime = (flushTime < waitTime) ? flushTime : waitTime;
+        }
+
+        if ((true == m_isSynced) && (false == isTxPending()) && (nullptr == m_claimedFrame))
+        {
+            uint8_t        channelNumber = 0U;
+            const uint8_t* payload       = nullptr;
+            uint8_t        payloadSize   = 0U;
+
+            for (uint8_t idx = 0U; (idx < tMaxChannels) && (0U != waitTime); idx++)
             {
-                if (0U == strncmp(channelName, m_txChannels[idx].m_name, CHANNEL_NAME_MAX_LEN))
+                const TxRateLimit* rateLimit = m_txRateLimits[idx];
+
+                if ((nullptr != rateLimit) && (true == rateLimit->hasDeferredFrame()))
                 {
-                    break;
+                    uint32_t deferTime = rateLimit->getWaitTime(
+                        currentTimestamp, (FRAME_HEADER_LEN + rateLimit->getDeferredLength()));
+
+                    waitTime = (deferTime < waitTime) ? deferTime : waitTime;
                 }
             }
+
+            if ((nullptr != m_txSource) && (true == m_txSource->front(channelNumber, payload, payloadSize)))
+            {
+                waitTime = 0U;
+            }
         }
 
-        return (idx == tMaxChannels) ? 0U : (idx + 1U);
+        return waitTime;
     }
 
     /**
-     * Creates a new TX Channel on the server.
-     * @param[in] channelName Name of the channel.
-     * It will not be checked if the name already exists.
-     * @param[in] dlc Length of the payload of this channel.
-     * @returns The channel number if succesfully created, or 0 if not able to create new channel.
+     * Check if bytes are waiting to be written, as the Stream has not accepted them all.
+     * Frames collected during an active batch are not pending, as they are written on flush().
+     * An event loop waits for the Stream to become writable then, and calls process().
+     * @returns true if bytes are pending, otherwise false.
      */
-    uint8_t createChannel(const char* channelName, uint8_t dlc)
+    bool isTxPending() const
     {
-        /* Using strnlen in case the name is not null-terminated. */
-        uint8_t nameLength = strnlen(channelName, CHANNEL_NAME_MAX_LEN);
-        uint8_t idx        = 0U;
+        return ((0U != m_txBuffer.size()) && (false == m_isTxBatchActive));
+    }
 
-        if ((nullptr != channelName) && (0U != nameLength) && (MAX_DATA_LEN >= dlc) && (0U != dlc) &&
-            (tMaxChannels > m_numberOfTxChannels))
-        {
-            /*
-             * Number of TX Channels corresponds to idx in TX Channel Array
-             * as these are ordered and Channels cannot be deleted.
-             */
-            memcpy(m_txChannels[m_numberOfTxChannels].m_name, channelName, nameLength);
-            m_txChannels[m_numberOfTxChannels].m_dlc = dlc;
+    /**
+     * Set the thresholds for flushing the TX staging buffer automatically.
+     * @param[in] sizeThreshold Number of buffered bytes that triggers a flush.
+     * Default is the size of the TX staging buffer.
+     * @param[in] period Maximum time in milliseconds that buffered bytes wait during a batch.
+     * Checked on process(). If 0, which is the default, there is no time threshold.
+     */
+    void setTxFlushThresholds(uint16_t sizeThreshold, uint32_t period)
+    {
+        m_txFlushThreshold = sizeThreshold;
+        m_txFlushPeriod    = period;
+    }
 
-            /* Increase Channel Counter. */
-            m_numberOfTxChannels++;
+    /**
+     * Get the number of bytes waiting to be written to the Stream.
+     * @returns Number of bytes in the TX staging buffer,
+     * or without TX staging buffer the number of bytes of a partially written frame.
+     */
+    uint16_t getPendingTxBytes() const
+    {
+        return m_txBuffer.size();
+    }
 
-            /* Provide Channel Number. Could be summarized with operation above. */
-            idx = m_numberOfTxChannels;
-        }
+    /**
+     * Send a frame with the selected bytes.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
+     */
+    bool sendData(uint8_t channelNumber, const void* payload, uint8_t payloadSize)
+    {
+        SendStatus status;
 
-        return idx;
+        return sendData(channelNumber, payload, payloadSize, status);
     }
 
     /**
-     * Suscribe to a Channel to receive the incoming data.
-     * @param[in] channelName Name of the Channel to suscribe to.
-     * @param[in] callback Callback to return the incoming data.
+     * Send a frame with the selected bytes.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @param[out] status Whether the frame has been sent, queued or rejected.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    void subscribeToChannel(const char* channelName, ChannelCallback callback)
+    bool sendData(uint8_t channelNumber, const void* payload, uint8_t payloadSize, SendStatus& status)
     {
-        if ((nullptr != channelName) && (nullptr != callback) && (tMaxChannels > m_numberOfPendingChannels))
+        status = SEND_REJECTED;
+
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (nullptr != payload) && (true == m_isSynced))
         {
-            /* Save Name and Callback for channel creation after response */
-            /* Using strnlen in case the name is not null-terminated. */
-            uint8_t nameLength = strnlen(channelName, CHANNEL_NAME_MAX_LEN);
+            status = sendFrame(channelNumber, payload, payloadSize);
+        }
 
-            /*
-             * Number of Pending Channels corresponds to idx in Pending Channel Array
-             * as these are ordered and Channels cannot be deleted.
-             */
-            memcpy(m_pendingSuscribeChannels[m_numberOfPendingChannels].m_name, channelName, nameLength);
-            m_pendingSuscribeChannels[m_numberOfPendingChannels].m_callback = callback;
+        return isSendAccepted(status);
+    }
 
-            /* Increase Channel Counter. */
-            m_numberOfPendingChannels++;
+    /**
+     * Send a frame with the selected bytes.
+     * @param[in] channelName Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
+     */
+    bool sendData(const char* channelName, const uint8_t* payload, uint8_t payloadSize)
+    {
+        SendStatus status;
+
+        return sendData(channelName, payload, payloadSize, status);
+    }
+
+    /**
+     * Send a frame with the selected bytes.
+     * @param[in] channelName Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @param[out] status Whether the frame has been sent, queued or rejected.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
+     */
+    bool sendData(const char* channelName, const uint8_t* payload, uint8_t payloadSize, SendStatus& status)
+    {
+        status = SEND_REJECTED;
+
+        if (nullptr != channelName)
+        {
+            (void)sendData(getTxChannelNumber(channelName), payload, payloadSize, status);
         }
+
+        return isSendAccepted(status);
     }
 
     /**
-     * Returns current Sync state of the SerialMuxProt Server.
+     * Send a frame with the selected bytes.
+     * The handle is only checked against its channel slot. No name lookup is performed.
+     * @param[in] handle Handle of the channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    bool isSynced()
+    bool sendData(const ChannelHandle& handle, const void* payload, uint8_t payloadSize)
     {
-        return m_isSynced;
+        SendStatus status;
+
+        return sendData(handle, payload, payloadSize, status);
     }
 
     /**
-     * Get the number of configured TX channels.
-     * @returns Number of configured Data Channels. The Command Channel is ignored here.
+     * Send a frame with the selected bytes.
+     * The handle is only checked against its channel slot. No name lookup is performed.
+     * @param[in] handle Handle of the channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @param[out] status Whether the frame has been sent, queued or rejected.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    uint8_t getNumberOfTxChannels()
+    bool sendData(const ChannelHandle& handle, const void* payload, uint8_t payloadSize, SendStatus& status)
     {
-        return m_numberOfTxChannels;
+        status = SEND_REJECTED;
+
+        if (true == isTxChannelHandleValid(handle))
+        {
+            (void)sendData(handle.m_channelNumber, payload, payloadSize, status);
+        }
+
+        return isSendAccepted(status);
     }
 
     /**
-     * Get the number of configured RX channels.
-     * @returns Number of configured Data Channels. The Command Channel is ignored here.
+     * Send a frame gathered from several payload fragments, e.g. the members of a record.
+     * The fragments are not copied into an intermediate frame.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] fragments Payload fragments, in order. The sum of their lengths must not exceed the DLC.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    uint8_t getNumberOfRxChannels()
+    bool sendDataGather(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount)
     {
-        return m_numberOfRxChannels;
+        SendStatus status;
+
+        return sendDataGather(channelNumber, fragments, fragmentCount, status);
     }
 
     /**
-     * Register a callback for the On-Synced event.
-     * The callback will be called when the client is synced to the server.
-     *
-     * @param[in] callback Callback to be registered.
-     *
-     * @returns true if the callback was registered, false otherwise.
+     * Send a frame gathered from several payload fragments, e.g. the members of a record.
+     * The fragments are not copied into an intermediate frame.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] fragments Payload fragments, in order. The sum of their lengths must not exceed the DLC.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @param[out] status Whether the frame has been sent, queued or rejected.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    bool registerOnSyncedCallback(EventCallback callback)
+    bool sendDataGather(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount, SendStatus& status)
     {
-        bool registered = false;
+        uint16_t payloadSize = 0U;
 
-        if (nullptr != callback)
+        status = SEND_REJECTED;
+
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (nullptr != fragments) && (0U != fragmentCount) &&
+            (MAX_TX_FRAGMENTS >= fragmentCount) && (true == m_isSynced))
         {
-            m_onSynced = callback;
-            registered = true;
+            for (uint8_t idx = 0U; idx < fragmentCount; idx++)
+            {
+                if ((nullptr == fragments[idx].m_data) && (0U != fragments[idx].m_length))
+                {
+                    payloadSize = UINT16_MAX;
+                    break;
+                }
+
+                payloadSize += fragments[idx].m_length;
+            }
+
+            if ((0U != payloadSize) && (getTxChannelDLC(channelNumber) >= payloadSize))
+            {
+                status = writeFrame(channelNumber, fragments, fragmentCount, static_cast<uint8_t>(payloadSize));
+            }
         }
 
-        return registered;
+        return isSendAccepted(status);
     }
 
     /**
-     * Register a callback for the On-DeSynced event.
-     * The callback will be called when the client is desynced from the server.
-     *
-     * @param[in] callback Callback to be registered.
-     *
-     * @returns true if the callback was registered, false otherwise.
+     * Reserve a frame to build its payload in place.
+     * With TX staging buffer, the frame is reserved directly in the buffer. Otherwise, a staging frame is used.
+     * The payload is sent by commit(). Until then, no other frame can be claimed. With TX staging buffer, the buffer
+     * is not flushed and other frames are rejected until then, so process() should not be called in between.
+     * Without, the remainder of a partially written frame is still written by process().
+     * @param[in] channelNumber Channel to send frame to.
+     * @returns Pointer to the payload of the DLC of the channel, or nullptr if no frame can be claimed or the
+     * remote is not subscribed to the channel while the subscription filter is enabled.
      */
-    bool registerOnDeSyncedCallback(EventCallback callback)
+    uint8_t* claim(uint8_t channelNumber)
     {
-        bool registered = false;
+        uint8_t* payload = nullptr;
+        uint8_t  dlc     = getTxChannelDLC(channelNumber);
 
-        if (nullptr != callback)
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (0U != dlc) && (true == m_isSynced) &&
+            (nullptr == m_claimedFrame) && (false == isTxSuppressed(channelNumber)) &&
+            (true == isTxRateAvailable(channelNumber, (FRAME_HEADER_LEN + dlc))))
         {
-            m_onDeSynced = callback;
-            registered   = true;
+            const uint16_t frameLength = FRAME_HEADER_LEN + dlc;
+
+            /* The claimed frame must follow a complete frame. */
+            closeSuperFrame();
+
+            if (frameLength > m_txBuffer.getFreeSpace())
+            {
+                /* Make room for the frame. */
+                (void)flushTxBuffer();
+            }
+
+            m_claimedFrame = m_txBuffer.claim(frameLength);
+
+            if (nullptr != m_claimedFrame)
+            {
+                m_claimedFrame[CHANNEL_FIELD_IDX] = channelNumber;
+                m_claimedFrame[DLC_FIELD_IDX]     = dlc;
+                payload                           = &m_claimedFrame[FRAME_HEADER_LEN];
+            }
         }
 
-        return registered;
+        return payload;
     }
 
-private:
     /**
-     * Control Channel Command: SYNC
-     * @param[in] rcvTimestamp Incoming Timestamp from client.
+     * Send the claimed frame. Its header and checksum are filled in place.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    void cmdSYNC(const uint32_t rcvTimestamp)
+    bool commit()
     {
-        ControlChannelPayload output;
-        output.commandByte = COMMANDS::SYNC_RSP;
-        output.timestamp   = rcvTimestamp;
+        SendStatus status;
 
-        /* Ignore return as SYNC_RSP can fail */
-        (void)send(CONTROL_CHANNEL_NUMBER, &output, sizeof(ControlChannelPayload));
+        return commit(status);
     }
 
     /**
-     * Control Channel Command: SYNC_RSP
-     * @param[in] rcvTimestamp Incoming Timestamp from client.
+     * Send the claimed frame. Its header and checksum are filled in place.
+     * @param[out] status Whether the frame has been sent, queued or rejected.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    void cmdSYNC_RSP(const uint32_t rcvTimestamp)
+    bool commit(SendStatus& status)
     {
-        /* Check Timestamp with m_lastSyncCommand */
-        if (rcvTimestamp == m_lastSyncCommand)
-        {
-            m_lastSyncResponse = m_lastSyncCommand;
-            setSyncedState(true);
+        uint8_t payloadSize = 0U;
 
-            /* Manage Pending Subscriptions. */
-            managePendingSubscriptions();
-        }
-        else
+        if (nullptr != m_claimedFrame)
         {
-            setSyncedState(false);
+            payloadSize = m_claimedFrame[DLC_FIELD_IDX];
         }
+
+        return commit(payloadSize, status);
     }
 
     /**
-     * Control Channel Command: SCRB
-     * @param[in] channelName Incoming Channel Name
+     * Send the first bytes of the claimed frame. Its header and checksum are filled in place.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    void cmdSCRB(const char* channelName)
+    bool commit(uint8_t payloadSize)
     {
-        ControlChannelPayload output;
-        output.commandByte   = COMMANDS::SCRB_RSP;
-        output.channelNumber = getTxChannelNumber(channelName);
-
-        /* Using strnlen in case the name is not null-terminated. */
-        uint8_t nameLength = strnlen(channelName, CHANNEL_NAME_MAX_LEN);
-
-        /* Name is always sent back. */
-        memcpy(output.channelName, channelName, nameLength);
+        SendStatus status;
 
-        if (false == send(CONTROL_CHANNEL_NUMBER, &output, sizeof(ControlChannelPayload)))
-        {
-            /* Fall out of sync if failed to send. */
-            setSyncedState(false);
-        }
+        return commit(payloadSize, status);
     }
 
     /**
-     * Control Channel Command: SCRB_RSP
-     * @param[in] channelName Incoming Channel Name
-     * @param[in] channelNumber Incoming Channel Number
+     * Send the first bytes of the claimed frame. Its header and checksum are filled in place.
+     * On an invalid payload size, the frame stays claimed.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @param[out] status Whether the frame has been sent, queued or rejected.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
      */
-    void cmdSCRB_RSP(const char* channelName, const uint8_t channelNumber)
+    bool commit(uint8_t payloadSize, SendStatus& status)
     {
-        if ((tMaxChannels >= channelNumber) && (0U != channelNumber) && (nullptr != channelName) &&
-            (0U < m_numberOfPendingChannels))
+        status = SEND_REJECTED;
+
+        if ((nullptr != m_claimedFrame) && (0U != payloadSize) && (m_claimedFrame[DLC_FIELD_IDX] >= payloadSize))
         {
-            for (uint8_t idx = 0; idx < tMaxChannels; idx++)
-            {
-                /* Check if a SCRB is pending. */
-                if (nullptr != m_pendingSuscribeChannels[idx].m_callback)
-                {
-                    /* Check if its the correct channel. */
-                    if (0U == strncmp(channelName, m_pendingSuscribeChannels[idx].m_name, CHANNEL_NAME_MAX_LEN))
-                    {
-                        /* Channel is found in the Server. */
-                        uint8_t channelArrayIndex = (channelNumber - 1U);
+            const uint16_t frameLength   = FRAME_HEADER_LEN + payloadSize;
+            const uint8_t  channelNumber = m_claimedFrame[CHANNEL_FIELD_IDX];
+            bool           isAccepted    = false;
 
-                        /* Channel is empty. Increase Counter*/
-                        if (nullptr == m_rxCallbacks[channelArrayIndex])
-                        {
-                            /* Increase RX Channel Counter. */
-                            m_numberOfRxChannels++;
-                        }
+            m_claimedFrame[DLC_FIELD_IDX] = payloadSize;
 
-                        m_rxCallbacks[channelArrayIndex] = m_pendingSuscribeChannels[idx].m_callback;
+            checksum(m_claimedFrame, &m_claimedFrame[CHECKSUM_FIELD_IDX]);
+            m_claimedFrame = nullptr;
 
-                        /* Channel is no longer pending. */
+            if (frameLength > m_txBuffer.getFreeSpace())
+            {
+                /* Finish a partially written frame first. The claimed frame itself is always reserved. */
+                (void)flushTxBuffer();
+            }
+
+            if (0U == m_txBuffer.size())
+            {
+                m_txPendingSince = m_currentTimestamp;
+            }
+
+            isAccepted = m_txBuffer.commit(m_stream, m_vectoredWriter, frameLength, getWritableBytes());
+
+            if (true == isAccepted)
+            {
+                prioritizeFrame(getTxPriority(channelNumber), frameLength);
+            }
+
+            status = completeFrame(isAccepted);
+
+            if ((nullptr != getTxRateLimit(channelNumber)) && (true == isSendAccepted(status)))
+            {
+                getTxRateLimit(channelNumber)->consume(frameLength);
+            }
+
+            if (true == isChannelInMask(m_conflatedChannels, channelNumber))
+            {
+                /* The committed frame replaces the queued one. */
+                eraseConflatedFrame(channelNumber);
+                trackConflatedFrame(channelNumber, status);
+            }
+        }
+
+        return isSendAccepted(status);
+    }
+
+    /**
+     * Release the claimed frame without sending it.
+     */
+    void abort()
+    {
+        m_claimedFrame = nullptr;
+    }
+
+    /**
+     * Register a VectoredWriter for the Stream.
+     * Without TX staging buffer, frames are then written with a single vectored write, without copying the
+     * payload into an intermediate frame.
+     * @param[in] writer VectoredWriter writing to the same Stream as the server, or nullptr to unregister.
+     */
+    void setVectoredWriter(VectoredWriter* writer)
+    {
+        m_vectoredWriter = writer;
+    }
+
+    /**
+     * Register a RxSource, which replaces the Stream for reading received bytes,
+     * e.g. a SerialMuxProtIngestRing filled by an interrupt service routine or DMA.
+     * The Stream is still used for writing.
+     * @param[in] source RxSource, or nullptr to read from the Stream again.
+     */
+    void setRxSource(RxSource* source)
+    {
+        m_rxSource = source;
+    }
+
+    /**
+     * Register a TxSource, whose pending frames are sent in process(), e.g. a SerialMuxProtPublishQueue filled by
+     * other threads. The thread calling process() is then the single writer of the Stream.
+     * @param[in] source TxSource, or nullptr to unregister.
+     */
+    void setTxSource(TxSource* source)
+    {
+        m_txSource = source;
+    }
+
+    /**
+     * Enable or disable TX back-pressure.
+     * If enabled, only as many bytes as reported by availableForWrite() of the Stream are written,
+     * so sending never blocks. The rest of the TX staging buffer is written on the next process().
+     * Without TX staging buffer, a frame is only written if it fits completely.
+     * @note Requires a Stream implementing availableForWrite().
+     * @param[in] isEnabled Enable back-pressure.
+     */
+    void enableTxBackPressure(bool isEnabled)
+    {
+        m_isTxBackPressureEnabled = isEnabled;
+    }
+
+    /**
+     * Enable or disable packing of data frames into super-frames.
+     * If enabled, data frames collected in the TX staging buffer are packed as records into a single frame on
+     * channel SUPER_FRAME_CHANNEL_NUMBER, with a single header and checksum. A single record is sent as normal frame.
+     * Received super-frames are always unpacked. Both peers must support super-frames.
+     * @note Requires the TX staging buffer, and SUPER_FRAME_CHANNEL_NUMBER must not be a data channel.
+     * @param[in] isEnabled Enable super-frames.
+     * @returns true if the setting has been applied, otherwise false.
+     */
+    bool enableSuperFrames(bool isEnabled)
+    {
+        bool isApplied = false;
+
+        if (false == isEnabled)
+        {
+            closeSuperFrame();
+            m_isSuperFrameEnabled = false;
+            isApplied             = true;
+        }
+        else if ((0U != tTxBufferSize) && (SUPER_FRAME_CHANNEL_NUMBER > tMaxChannels))
+        {
+            m_isSuperFrameEnabled = true;
+            isApplied             = true;
+        }
+        else
+        {
+            /* Super-frames are not supported by this configuration. */
+            ;
+        }
+
+        return isApplied;
+    }
+
+    /**
+     * Enable or disable the subscription filter of the TX channels.
+     * If enabled, frames are only encoded and sent on channels the remote has subscribed to. Other frames are
+     * reported as SEND_SUPPRESSED and counted in the TX statistics. Subscriptions are remembered while the remote
+     * is desynced, as the remote only subscribes once.
+     * @param[in] isEnabled Enable the subscription filter.
+     */
+    void enableTxSubscriptionFilter(bool isEnabled)
+    {
+        m_isTxSubscriptionFilterEnabled = isEnabled;
+    }
+
+    /**
+     * Check if the remote is subscribed to a TX channel.
+     * @param[in] channelNumber Number of the TX channel.
+     * @returns true if the remote has subscribed to the channel, otherwise false.
+     */
+    bool isTxChannelSubscribed(uint8_t channelNumber) const
+    {
+        return isChannelInMask(m_remoteSubscriptions, channelNumber);
+    }
+
+    /**
+     * Enable or disable conflation of a TX channel, e.g. for state-like data where only the newest value matters.
+     * A conflated channel holds at most one frame in the TX staging buffer. A new frame replaces the queued one,
+     * as long as no byte of it has been written yet. Replaced frames are counted in the TX statistics.
+     * @note Requires the TX staging buffer. Frames of conflated channels are not packed into super-frames.
+     * @param[in] channelNumber Number of the TX channel.
+     * @param[in] isEnabled Enable conflation.
+     * @returns true if the setting has been applied, otherwise false.
+     */
+    bool setTxChannelConflation(uint8_t channelNumber, bool isEnabled)
+    {
+        bool isApplied = false;
+
+        if ((0U != tTxBufferSize) && (CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber))
+        {
+            setChannelInMask(m_conflatedChannels, channelNumber, isEnabled);
+            setChannelInMask(m_pendingConflatedFrames, channelNumber, false);
+            isApplied = true;
+        }
+
+        return isApplied;
+    }
+
+    /**
+     * Set the priority class of a TX channel.
+     * Frames in the TX staging buffer are written ordered by priority class, and in sending order within a class.
+     * The Control Channel, including SYNC and SCRB_RSP, has the highest class. A frame which is already being
+     * written is not overtaken. The worst-case queueing delay of each class is reported in the TX statistics.
+     * @note Requires the TX staging buffer. Data channels have TX_PRIORITY_NORMAL by default.
+     * @param[in] channelNumber Number of the TX channel.
+     * @param[in] priority Priority class. TX_PRIORITY_CONTROL is reserved for the Control Channel.
+     * @returns true if the priority class has been applied, otherwise false.
+     */
+    bool setTxChannelPriority(uint8_t channelNumber, TxPriority priority)
+    {
+        bool isApplied = false;
+
+        if ((0U != tTxBufferSize) && (CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber) &&
+            (TX_PRIORITY_CONTROL != priority) && (TX_PRIORITY_CLASSES > priority))
+        {
+            m_txChannels[channelNumber - 1U].m_priority = priority;
+            isApplied                                   = true;
+        }
+
+        return isApplied;
+    }
+
+    /**
+     * Limit the rate of a TX channel with a token bucket.
+     * Frames exceeding the budget are dropped or deferred according to the policy of the rate limit, and counted
+     * by it. While the budget is exceeded, claim() returns nullptr for the channel.
+     * @param[in] channelNumber Number of the TX channel.
+     * @param[in] rateLimit Rate limit owned by the application, or nullptr to remove the limit.
+     * @returns true if the rate limit has been applied, otherwise false.
+     */
+    bool setTxChannelRateLimit(uint8_t channelNumber, TxRateLimit* rateLimit)
+    {
+        bool isApplied = false;
+
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber))
+        {
+            m_txRateLimits[channelNumber - 1U] = rateLimit;
+            isApplied                          = true;
+        }
+
+        return isApplied;
+    }
+
+    /**
+     * Get the handle of a TX channel by its name.
+     * Resolve it once and use it for sending afterwards.
+     * @param[in] channelName Name of Channel
+     * @returns Handle of the channel. It is not resolved if no channel with the name is present.
+     */
+    ChannelHandle getTxChannelHandle(const char* channelName) const
+    {
+        return getTxChannelHandle(getTxChannelNumber(channelName));
+    }
+
+    /**
+     * Get the handle of a TX channel by its number.
+     * @param[in] channelNumber Number of the channel, as returned by createChannel().
+     * @returns Handle of the channel. It is not resolved if the channel does not exist.
+     */
+    ChannelHandle getTxChannelHandle(uint8_t channelNumber) const
+    {
+        ChannelHandle handle;
+
+        if ((0U != channelNumber) && (m_numberOfTxChannels >= channelNumber))
+        {
+            handle.m_channelNumber = channelNumber;
+            handle.m_generation    = m_txChannels[channelNumber - 1U].m_generation;
+        }
+
+        return handle;
+    }
+
+    /**
+     * Check if a TX channel handle refers to the current state of its channel.
+     * @param[in] handle Handle of the channel.
+     * @returns true if the handle is valid, otherwise false if it is unresolved or stale.
+     */
+    bool isTxChannelHandleValid(const ChannelHandle& handle) const
+    {
+        return ((true == handle.isResolved()) && (0U != handle.m_channelNumber) &&
+                (m_numberOfTxChannels >= handle.m_channelNumber) &&
+                (m_txChannels[handle.m_channelNumber - 1U].m_generation == handle.m_generation));
+    }
+
+    /**
+     * Get the handle of a subscribed RX channel by its name.
+     * The channel must have been confirmed by the remote, see getNumberOfRxChannels().
+     * @param[in] channelName Name of Channel
+     * @returns Handle of the channel. It is not resolved if the channel is not subscribed.
+     */
+    ChannelHandle getRxChannelHandle(const char* channelName) const
+    {
+        ChannelHandle handle;
+
+        if (nullptr != channelName)
+        {
+            for (uint8_t idx = 0U; idx < tMaxChannels; idx++)
+            {
+                if ((nullptr != m_rxChannels[idx].m_callback) &&
+                    (0U == strncmp(channelName, m_rxChannels[idx].m_name, CHANNEL_NAME_MAX_LEN)))
+                {
+                    handle.m_channelNumber = (idx + 1U);
+                    handle.m_generation    = m_rxChannels[idx].m_generation;
+                    break;
+                }
+            }
+        }
+
+        return handle;
+    }
+
+    /**
+     * Check if a RX channel handle refers to the current subscription of its channel.
+     * A handle becomes stale when the remote assigns its channel number again.
+     * @param[in] handle Handle of the channel.
+     * @returns true if the handle is valid, otherwise false if it is unresolved or stale.
+     */
+    bool isRxChannelHandleValid(const ChannelHandle& handle) const
+    {
+        return ((true == handle.isResolved()) && (0U != handle.m_channelNumber) &&
+                (tMaxChannels >= handle.m_channelNumber) &&
+                (m_rxChannels[handle.m_channelNumber - 1U].m_generation == handle.m_generation));
+    }
+
+    /**
+     * Get Number of a TX channel by its name.
+     * @param[in] channelName Name of Channel
+     * @returns Number of the Channel, or 0 if not channel with the name is present.
+     */
+    uint8_t getTxChannelNumber(const char* channelName) const
+    {
+        uint8_t idx = tMaxChannels;
+
+        if (nullptr != channelName)
+        {
+            for (idx = 0U; idx < tMaxChannels; idx++)
+            {
+                if (0U == strncmp(channelName, m_txChannels[idx].m_name, CHANNEL_NAME_MAX_LEN))
+                {
+                    break;
+                }
+            }
+        }
+
+        return (idx == tMaxChannels) ? 0U : (idx + 1U);
+    }
+
+    /**
+     * Creates a new TX Channel on the server.
+     * @param[in] channelName Name of the channel.
+     * It will not be checked if the name already exists.
+     * @param[in] dlc Maximum length of the payload of this channel.
+     * @returns The channel number if succesfully created, or 0 if not able to create new channel.
+     */
+    uint8_t createChannel(const char* channelName, uint8_t dlc)
+    {
+        /* Using strnlen in case the name is not null-terminated. */
+        uint8_t nameLength = strnlen(channelName, CHANNEL_NAME_MAX_LEN);
+        uint8_t idx        = 0U;
+
+        if ((nullptr != channelName) && (0U != nameLength) && (tMaxDataLen >= dlc) && (0U != dlc) &&
+            (tMaxChannels > m_numberOfTxChannels))
+        {
+            /*
+             * Number of TX Channels corresponds to idx in TX Channel Array
+             * as these are ordered and Channels cannot be deleted.
+             */
+            memcpy(m_txChannels[m_numberOfTxChannels].m_name, channelName, nameLength);
+            m_txChannels[m_numberOfTxChannels].m_dlc        = dlc;
+            m_txChannels[m_numberOfTxChannels].m_generation = nextGeneration();
+
+            /* Increase Channel Counter. */
+            m_numberOfTxChannels++;
+
+            /* Provide Channel Number. Could be summarized with operation above. */
+            idx = m_numberOfTxChannels;
+        }
+
+        return idx;
+    }
+
+    /**
+     * Suscribe to a Channel to receive the incoming data.
+     * @param[in] channelName Name of the Channel to suscribe to.
+     * @param[in] callback Callback to return the incoming data.
+     */
+    void subscribeToChannel(const char* channelName, ChannelCallback callback)
+    {
+        if ((nullptr != channelName) && (nullptr != callback) && (tMaxChannels > m_numberOfPendingChannels))
+        {
+            /* Save Name and Callback for channel creation after response */
+            /* Using strnlen in case the name is not null-terminated. */
+            uint8_t nameLength = strnlen(channelName, CHANNEL_NAME_MAX_LEN);
+
+            /*
+             * Number of Pending Channels corresponds to idx in Pending Channel Array
+             * as these are ordered and Channels cannot be deleted.
+             */
+            memcpy(m_pendingSuscribeChannels[m_numberOfPendingChannels].m_name, channelName, nameLength);
+            m_pendingSuscribeChannels[m_numberOfPendingChannels].m_callback = callback;
+
+            /* Increase Channel Counter. */
+            m_numberOfPendingChannels++;
+        }
+    }
+
+    /**
+     * Returns current Sync state of the SerialMuxProt Server.
+     */
+    bool isSynced()
+    {
+        return m_isSynced;
+    }
+
+    /**
+     * Get the number of configured TX channels.
+     * @returns Number of configured Data Channels. The Command Channel is ignored here.
+     */
+    uint8_t getNumberOfTxChannels()
+    {
+        return m_numberOfTxChannels;
+    }
+
+    /**
+     * Get the number of configured RX channels.
+     * @returns Number of configured Data Channels. The Command Channel is ignored here.
+     */
+    uint8_t getNumberOfRxChannels()
+    {
+        return m_numberOfRxChannels;
+    }
+
+    /**
+     * Get the payload limit advertised by the client in its last SYNC or SYNC_RSP.
+     * The server does not sync as long as it differs from MAX_PAYLOAD_LEN.
+     * @returns Payload limit of the client, or 0 if not received yet.
+     */
+    uint8_t getRemoteMaxDataLength() const
+    {
+        return m_remoteMaxDataLength;
+    }
+
+    /**
+     * Get the statistics of the RX path.
+     * @returns Resynchronization counters.
+     */
+    const RxStatistics& getRxStatistics() const
+    {
+        return m_rxStatistics;
+    }
+
+    /**
+     * Get the statistics of the TX path.
+     * @returns TX counters.
+     */
+    const TxStatistics& getTxStatistics() const
+    {
+        return m_txStatistics;
+    }
+
+    /**
+     * Register a callback for the On-Synced event.
+     * The callback will be called when the client is synced to the server.
+     *
+     * @param[in] callback Callback to be registered.
+     *
+     * @returns true if the callback was registered, false otherwise.
+     */
+    bool registerOnSyncedCallback(EventCallback callback)
+    {
+        bool registered = false;
+
+        if (nullptr != callback)
+        {
+            m_onSynced = callback;
+            registered = true;
+        }
+
+        return registered;
+    }
+
+    /**
+     * Register a callback for the On-DeSynced event.
+     * The callback will be called when the client is desynced from the server.
+     *
+     * @param[in] callback Callback to be registered.
+     *
+     * @returns true if the callback was registered, false otherwise.
+     */
+    bool registerOnDeSyncedCallback(EventCallback callback)
+    {
+        bool registered = false;
+
+        if (nullptr != callback)
+        {
+            m_onDeSynced = callback;
+            registered   = true;
+        }
+
+        return registered;
+    }
+
+private:
+    /**
+     * Control Channel Command: SYNC
+     * Not answered if the payload limit of the client differs, so the client does not sync.
+     * @param[in] rcvTimestamp Incoming Timestamp from client.
+     * @param[in] rcvPayloadLimit Incoming advertised payload limit of the client.
+     */
+    void cmdSYNC(const uint32_t rcvTimestamp, const uint8_t rcvPayloadLimit)
+    {
+        m_remoteMaxDataLength = decodePayloadLimit(rcvPayloadLimit);
+
+        if (tMaxDataLen == m_remoteMaxDataLength)
+        {
+            ControlChannelPayload output;
+            output.commandByte   = COMMANDS::SYNC_RSP;
+            output.timestamp     = rcvTimestamp;
+            output.channelNumber = encodePayloadLimit();
+
+            /* Ignore return as SYNC_RSP can fail */
+            (void)send(CONTROL_CHANNEL_NUMBER, &output, sizeof(ControlChannelPayload));
+        }
+    }
+
+    /**
+     * Control Channel Command: SYNC_RSP
+     * @param[in] rcvTimestamp Incoming Timestamp from client.
+     * @param[in] rcvPayloadLimit Incoming advertised payload limit of the client.
+     */
+    void cmdSYNC_RSP(const uint32_t rcvTimestamp, const uint8_t rcvPayloadLimit)
+    {
+        m_remoteMaxDataLength = decodePayloadLimit(rcvPayloadLimit);
+
+        /* Check Timestamp with m_lastSyncCommand and the payload limit of the client. */
+        if ((rcvTimestamp == m_lastSyncCommand) && (tMaxDataLen == m_remoteMaxDataLength))
+        {
+            m_lastSyncResponse = m_lastSyncCommand;
+            setSyncedState(true);
+
+            /* Manage Pending Subscriptions. */
+            managePendingSubscriptions();
+        }
+        else
+        {
+            setSyncedState(false);
+        }
+    }
+
+    /**
+     * Control Channel Command: SCRB
+     * @param[in] channelName Incoming Channel Name
+     */
+    void cmdSCRB(const char* channelName)
+    {
+        ControlChannelPayload output;
+        output.commandByte   = COMMANDS::SCRB_RSP;
+        output.channelNumber = getTxChannelNumber(channelName);
+
+        /* Using strnlen in case the name is not null-terminated. */
+        uint8_t nameLength = strnlen(channelName, CHANNEL_NAME_MAX_LEN);
+
+        /* Remember the subscription of the remote. */
+        setChannelInMask(m_remoteSubscriptions, output.channelNumber, true);
+
+        /* Name is always sent back. */
+        memcpy(output.channelName, channelName, nameLength);
+
+        if (false == send(CONTROL_CHANNEL_NUMBER, &output, sizeof(ControlChannelPayload)))
+        {
+            /* Fall out of sync if failed to send. */
+            setSyncedState(false);
+        }
+    }
+
+    /**
+     * Control Channel Command: SCRB_RSP
+     * @param[in] channelName Incoming Channel Name
+     * @param[in] channelNumber Incoming Channel Number
+     */
+    void cmdSCRB_RSP(const char* channelName, const uint8_t channelNumber)
+    {
+        if ((tMaxChannels >= channelNumber) && (0U != channelNumber) && (nullptr != channelName) &&
+            (0U < m_numberOfPendingChannels))
+        {
+            for (uint8_t idx = 0; idx < tMaxChannels; idx++)
+            {
+                /* Check if a SCRB is pending. */
+                if (nullptr != m_pendingSuscribeChannels[idx].m_callback)
+                {
+                    /* Check if its the correct channel. */
+                    if (0U == strncmp(channelName, m_pendingSuscribeChannels[idx].m_name, CHANNEL_NAME_MAX_LEN))
+                    {
+                        /* Channel is found in the Server. */
+                        uint8_t channelArrayIndex = (channelNumber - 1U);
+
+                        /* Channel is empty. Increase Counter*/
+                        if (nullptr == m_rxChannels[channelArrayIndex].m_callback)
+                        {
+                            /* Increase RX Channel Counter. */
+                            m_numberOfRxChannels++;
+                        }
+
+                        memcpy(m_rxChannels[channelArrayIndex].m_name, m_pendingSuscribeChannels[idx].m_name,
+                               CHANNEL_NAME_MAX_LEN);
+                        m_rxChannels[channelArrayIndex].m_callback   = m_pendingSuscribeChannels[idx].m_callback;
+                        m_rxChannels[channelArrayIndex].m_generation = nextGeneration();
+
+                        /* Channel is no longer pending. */
                         m_pendingSuscribeChannels[idx].m_callback = nullptr;
 
-                        /* Decrease Pending Channel Counter. */
-                        m_numberOfPendingChannels--;
-                        break;
+                        /* Decrease Pending Channel Counter. */
+                        m_numberOfPendingChannels--;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Callback for the Control Channel
+     * @param[in] payload Payload of received frame.
+     * @param[in] payloadSize Length of Payload
+     */
+    void callbackControlChannel(const uint8_t* payload, const uint8_t payloadSize)
+    {
+        if ((nullptr != payload) && (CONTROL_CHANNEL_PAYLOAD_LENGTH == payloadSize))
+        {
+            const ControlChannelPayload* parsedPayload = reinterpret_cast<const ControlChannelPayload*>(payload);
+
+            switch (parsedPayload->commandByte)
+            {
+            case COMMANDS::SYNC:
+                cmdSYNC(parsedPayload->timestamp, parsedPayload->channelNumber);
+                break;
+
+            case COMMANDS::SYNC_RSP:
+                cmdSYNC_RSP(parsedPayload->timestamp, parsedPayload->channelNumber);
+                break;
+
+            case COMMANDS::SCRB:
+                cmdSCRB(parsedPayload->channelName);
+                break;
+
+            case COMMANDS::SCRB_RSP:
+                cmdSCRB_RSP(parsedPayload->channelName, parsedPayload->channelNumber);
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    /**
+     * Receive and process RX Data.
+     * @param[in] maxFrames Maximum number of frames to process.
+     * @param[in] maxBytes Maximum number of bytes to read from the Stream.
+     * @returns Number of dispatched frames and number of bytes still pending in the Stream and the RX buffer.
+     */
+    RxDrainResult processRxData(uint16_t maxFrames, uint32_t maxBytes)
+    {
+        RxDrainResult result;
+        uint32_t      consumedBytes = 0U;
+        bool          isDispatched  = true;
+
+        /* Continue only as long as frames are dispatched and the budget is not exhausted. */
+        while ((true == isDispatched) && (maxFrames > result.m_dispatchedFrames) && (maxBytes > consumedBytes))
+        {
+            uint32_t stepBytes = 0U;
+
+            isDispatched = processRxFrame((maxBytes - consumedBytes), stepBytes);
+
+            if (true == isDispatched)
+            {
+                result.m_dispatchedFrames++;
+            }
+
+            consumedBytes += stepBytes;
+        }
+
+        result.m_pendingBytes = getRxAvailableBytes() + m_rxBuffer.size();
+
+        return result;
+    }
+
+    /**
+     * Receive and process a single RX Frame.
+     * The header and the payload are only read from the Stream if they are completely available.
+     * Invalid headers and frames are not discarded as a whole. Instead, the RX window slides one byte
+     * at a time until the next plausible header with a matching checksum is found.
+     * @param[in] maxBytes Maximum number of bytes to read from the Stream.
+     * @param[out] readBytes Number of bytes read from the Stream.
+     * @returns true if a valid frame has been dispatched, otherwise false.
+     */
+    bool processRxFrame(uint32_t maxBytes, uint32_t& readBytes)
+    {
+        bool isDispatched = false;
+        bool isWaiting    = false;
+
+        while ((false == isDispatched) && (false == isWaiting))
+        {
+            /* Header must be read. */
+            if (FRAME_HEADER_LEN > m_rxBuffer.size())
+            {
+                readBytes += fillRxBuffer((FRAME_HEADER_LEN - m_rxBuffer.size()), (maxBytes - readBytes));
+            }
+
+            if (FRAME_HEADER_LEN > m_rxBuffer.size())
+            {
+                /* Wait for the rest of the header. */
+                isWaiting = true;
+            }
+            else if (false ==
+                     isHeaderPlausible(m_rxBuffer.peek(CHANNEL_FIELD_IDX), m_rxBuffer.peek(DLC_FIELD_IDX)))
+            {
+                /* Invalid header. */
+                slideRxWindow();
+            }
+            else
+            {
+                /* Header has been read. Get DLC of Rx Channel using Header. */
+                uint16_t frameLength = FRAME_HEADER_LEN + m_rxBuffer.peek(DLC_FIELD_IDX);
+
+                if (frameLength > m_rxBuffer.size())
+                {
+                    readBytes += fillRxBuffer((frameLength - m_rxBuffer.size()), (maxBytes - readBytes));
+                }
+
+                if (frameLength > m_rxBuffer.size())
+                {
+                    m_rxAttempts++;
+
+                    if (FRAME_MAX_LEN < m_rxAttempts)
+                    {
+                        /* Payload never arrived. Header is most likely corrupted. */
+                        slideRxWindow();
+                    }
+                    else
+                    {
+                        /* Wait for the rest of the payload. */
+                        isWaiting = true;
+                    }
+                }
+                else
+                {
+                    const uint8_t* frame = m_rxBuffer.getFrame(frameLength);
+
+                    if (false == isFrameValid(frame))
+                    {
+                        /* Checksum mismatch. */
+                        slideRxWindow();
+                    }
+                    else
+                    {
+                        finishRxResync();
+                        dispatchFrame(frame);
+                        isDispatched = true;
+
+                        /* Frame received. Cleaning! */
+                        m_rxBuffer.discard(frameLength);
+                        m_rxAttempts = 0U;
+                    }
+                }
+            }
+        }
+
+        return isDispatched;
+    }
+
+    /**
+     * Read received bytes into the RX buffer, from the RxSource if registered, otherwise from the Stream.
+     * @param[in] requiredBytes Number of bytes the parser is waiting for.
+     * @param[in] maxBytes Maximum number of bytes allowed to be read.
+     * @returns Number of bytes read.
+     */
+    uint32_t fillRxBuffer(uint16_t requiredBytes, uint32_t maxBytes)
+    {
+        uint32_t readBytes = 0U;
+
+        if (nullptr != m_rxSource)
+        {
+            readBytes = m_rxBuffer.fill(*m_rxSource, requiredBytes, maxBytes);
+        }
+        else
+        {
+            readBytes = m_rxBuffer.fill(m_stream, requiredBytes, maxBytes);
+        }
+
+        return readBytes;
+    }
+
+    /**
+     * Get the number of received bytes waiting to be read, from the RxSource if registered, otherwise from the
+     * Stream.
+     * @returns Number of available bytes.
+     */
+    uint32_t getRxAvailableBytes()
+    {
+        int availableBytes = (nullptr != m_rxSource) ? m_rxSource->available() : m_stream.available();
+
+        return (0 < availableBytes) ? static_cast<uint32_t>(availableBytes) : 0U;
+    }
+
+    /**
+     * Check if a received header can be the start of a valid frame.
+     * @param[in] channel Channel field of the header.
+     * @param[in] dlc DLC field of the header.
+     * @returns true if the channel and its DLC are plausible, otherwise false.
+     */
+    bool isHeaderPlausible(uint8_t channel, uint8_t dlc) const
+    {
+        bool isPlausible = false;
+
+        if (CONTROL_CHANNEL_NUMBER == channel)
+        {
+            isPlausible = (CONTROL_CHANNEL_PAYLOAD_LENGTH == dlc);
+        }
+        else
+        {
+            /* DLC = 0 means that the channel does not exist. */
+            isPlausible = ((0U != dlc) && (tMaxDataLen >= dlc));
+        }
+
+        return isPlausible;
+    }
+
+    /**
+     * Discard the first byte of the RX buffer and keep the rest of the received bytes
+     * as candidates for the next header.
+     */
+    void slideRxWindow()
+    {
+        if (0U != m_rxBuffer.size())
+        {
+            m_rxBuffer.discard(1U);
+
+            if (0U == m_rxResyncDiscardedBytes)
+            {
+                m_rxStatistics.m_resyncEvents++;
+            }
+
+            m_rxResyncDiscardedBytes++;
+            m_rxStatistics.m_discardedBytes++;
+        }
+
+        m_rxAttempts = 0U;
+    }
+
+    /**
+     * Finish a running resynchronization, as a valid frame has been found.
+     */
+    void finishRxResync()
+    {
+        if (0U != m_rxResyncDiscardedBytes)
+        {
+            m_rxStatistics.m_lastResyncDiscardedBytes = m_rxResyncDiscardedBytes;
+
+            if (m_rxStatistics.m_maxResyncDiscardedBytes < m_rxResyncDiscardedBytes)
+            {
+                m_rxStatistics.m_maxResyncDiscardedBytes = m_rxResyncDiscardedBytes;
+            }
+
+            m_rxResyncDiscardedBytes = 0U;
+        }
+    }
+
+    /**
+     * Dispatch a valid frame to its channel.
+     * The payload is handed to the callback in place, without copying it out of the RX buffer.
+     * @param[in] frame Received frame.
+     */
+    void dispatchFrame(const uint8_t* frame)
+    {
+        uint8_t        channelNumber = frame[CHANNEL_FIELD_IDX];
+        uint8_t        dlc           = frame[DLC_FIELD_IDX];
+        const uint8_t* payload       = &frame[FRAME_HEADER_LEN];
+
+        /* Differenciate between Control and Data Channels. */
+        if (CONTROL_CHANNEL_NUMBER == channelNumber)
+        {
+            callbackControlChannel(payload, dlc);
+        }
+        else if ((SUPER_FRAME_CHANNEL_NUMBER == channelNumber) && (SUPER_FRAME_CHANNEL_NUMBER > tMaxChannels))
+        {
+            dispatchSuperFrame(payload, dlc);
+        }
+        else if ((tMaxChannels >= channelNumber) && (nullptr != m_rxChannels[channelNumber - 1U].m_callback))
+        {
+            /* Callback */
+            m_rxChannels[channelNumber - 1U].m_callback(payload, dlc, m_userData);
+        }
+        else
+        {
+            /* Not subscribed to this channel. */
+            ;
+        }
+    }
+
+    /**
+     * Periodic heartbeat.
+     * Sends SYNC Command depending on the current Sync state.
+     * @param[in] currentTimestamp Time in milliseconds.
+     */
+    void heartbeat(const uint32_t currentTimestamp)
+    {
+        uint32_t heartbeatPeriod = HEATBEAT_PERIOD_UNSYNCED;
+
+        if (true == m_isSynced)
+        {
+            heartbeatPeriod = HEATBEAT_PERIOD_SYNCED;
+        }
+
+        if ((currentTimestamp - m_lastSyncCommand) >= heartbeatPeriod)
+        {
+            /* Timeout. */
+            if (m_lastSyncCommand != m_lastSyncResponse)
+            {
+                setSyncedState(false);
+            }
+
+            /* Send SYNC Command. */
+            ControlChannelPayload payload;
+            payload.commandByte   = COMMANDS::SYNC;
+            payload.timestamp     = currentTimestamp;
+            payload.channelNumber = encodePayloadLimit();
+
+            if (true == send(CONTROL_CHANNEL_NUMBER, &payload, sizeof(ControlChannelPayload)))
+            {
+                m_lastSyncCommand = currentTimestamp;
+            }
+        }
+    }
+
+    /**
+     * Get the time remaining until a period has elapsed.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @param[in] startTimestamp Start of the period in milliseconds.
+     * @param[in] period Period in milliseconds.
+     * @returns Remaining time in milliseconds. 0 if the period has elapsed.
+     */
+    static uint32_t getRemainingTime(uint32_t currentTimestamp, uint32_t startTimestamp, uint32_t period)
+    {
+        uint32_t elapsed = currentTimestamp - startTimestamp;
+
+        return (elapsed >= period) ? 0U : (period - elapsed);
+    }
+
+    /**
+     * Subscribe to any pending Channels if synced to server.
+     */
+    void managePendingSubscriptions()
+    {
+        if ((true == m_isSynced) && (0U < m_numberOfPendingChannels))
+        {
+            for (uint8_t idx = 0; idx < tMaxChannels; idx++)
+            {
+                if (nullptr != m_pendingSuscribeChannels[idx].m_callback)
+                {
+                    /* Suscribe to channel. */
+                    /* Using strnlen in case the name is not null-terminated. */
+                    uint8_t nameLength = strnlen(m_pendingSuscribeChannels[idx].m_name, CHANNEL_NAME_MAX_LEN);
+                    ControlChannelPayload output;
+                    output.commandByte = COMMANDS::SCRB;
+                    memcpy(output.channelName, m_pendingSuscribeChannels[idx].m_name, nameLength);
+
+                    if (false == send(CONTROL_CHANNEL_NUMBER, &output, sizeof(ControlChannelPayload)))
+                    {
+                        /* Out-of-Sync on failed send. */
+                        setSyncedState(false);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Send a frame with the selected bytes.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @returns If payload succesfully sent or queued, returns true. Otherwise, false.
+     */
+    bool send(uint8_t channelNumber, const void* payload, uint8_t payloadSize)
+    {
+        return isSendAccepted(sendFrame(channelNumber, payload, payloadSize));
+    }
+
+    /**
+     * Send a frame with the selected bytes.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] payloadSize Amount of bytes to send. Must not be greater than the DLC of the channel.
+     * @returns Whether the frame has been sent, queued or rejected.
+     */
+    SendStatus sendFrame(uint8_t channelNumber, const void* payload, uint8_t payloadSize)
+    {
+        SendStatus status     = SEND_REJECTED;
+        uint8_t    channelDLC = getTxChannelDLC(channelNumber);
+
+        if ((nullptr != payload) && (0U != payloadSize) && (channelDLC >= payloadSize) &&
+            (true == m_isSynced || (CONTROL_CHANNEL_NUMBER == channelNumber)))
+        {
+            status = writeFrame(channelNumber, payload, payloadSize);
+        }
+
+        return status;
+    }
+
+    /**
+     * Check if a frame has been accepted for sending.
+     * @param[in] status Result of sending the frame.
+     * @returns true if the frame has been sent or queued, otherwise false.
+     */
+    static bool isSendAccepted(SendStatus status)
+    {
+        return ((SEND_SENT == status) || (SEND_QUEUED == status) || (SEND_DEFERRED == status));
+    }
+
+    /**
+     * Send a frame on a channel whose DLC has been checked at compile time.
+     * Used by TypedChannel. Only the handle and the sync state are checked.
+     * @param[in] handle Handle of the channel to send frame to.
+     * @param[in] payload Byte buffer to be sent. Its size must be the DLC of the channel.
+     * @param[in] dlc DLC of the channel.
+     * @returns If payload succesfully sent, returns true. Otherwise, false.
+     */
+    bool sendTypedData(const ChannelHandle& handle, const void* payload, uint8_t dlc)
+    {
+        bool frameSent = false;
+
+        if ((true == m_isSynced) && (true == isTxChannelHandleValid(handle)))
+        {
+            frameSent = isSendAccepted(writeFrame(handle.m_channelNumber, payload, dlc));
+        }
+
+        return frameSent;
+    }
+
+    /**
+     * Build a frame and write it to the Stream or the TX staging buffer.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] payload Byte buffer to be sent.
+     * @param[in] dlc Amount of bytes to send.
+     * @returns Whether the frame has been sent, queued or rejected because the TX queue is full.
+     */
+    SendStatus writeFrame(uint8_t channelNumber, const void* payload, uint8_t dlc)
+    {
+        IoVector fragment(payload, dlc);
+
+        return writeFrame(channelNumber, &fragment, 1U, dlc);
+    }
+
+    /**
+     * Build a frame out of payload fragments and write it to the Stream or the TX staging buffer.
+     * If super-frames are enabled, data frames are appended as record to the open super-frame.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] fragments Payload fragments, in order.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @param[in] dlc Sum of the fragment lengths.
+     * @returns Whether the frame has been sent, queued or rejected because the TX queue is full.
+     */
+    SendStatus writeFrame(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount, uint8_t dlc)
+    {
+        SendStatus   status    = SEND_QUEUE_FULL;
+        TxRateLimit* rateLimit = getTxRateLimit(channelNumber);
+
+        if (true == isTxSuppressed(channelNumber))
+        {
+            status = SEND_SUPPRESSED;
+        }
+        else if (false == isTxRateAvailable(channelNumber, (FRAME_HEADER_LEN + dlc)))
+        {
+            status = (true == rateLimit->defer(fragments, fragmentCount, dlc)) ? SEND_DEFERRED : SEND_DROPPED;
+        }
+        else
+        {
+            status = queueFrame(channelNumber, fragments, fragmentCount, dlc);
+
+            if ((nullptr != rateLimit) && (true == isSendAccepted(status)))
+            {
+                rateLimit->consume(FRAME_HEADER_LEN + dlc);
+            }
+        }
+
+        return status;
+    }
+
+    /**
+     * Queue a frame out of payload fragments in the TX staging buffer, or write it to the Stream.
+     * If enabled, conflation and super-frames apply.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] fragments Payload fragments, in order.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @param[in] dlc Sum of the fragment lengths.
+     * @returns Whether the frame has been sent, queued or rejected because the TX queue is full.
+     */
+    SendStatus queueFrame(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount, uint8_t dlc)
+    {
+        SendStatus status = SEND_QUEUE_FULL;
+
+        /* A frame claimed in the TX staging buffer must not be overwritten. */
+        if ((0U == tTxBufferSize) || (nullptr == m_claimedFrame))
+        {
+            if (true == isChannelInMask(m_conflatedChannels, channelNumber))
+            {
+                status = writeConflatedFrame(channelNumber, fragments, fragmentCount, dlc);
+            }
+            else if (true == isSuperFrameRecord(channelNumber, dlc))
+            {
+                status = completeFrame(appendSuperFrameRecord(channelNumber, fragments, fragmentCount, dlc));
+            }
+            else
+            {
+                closeSuperFrame();
+                status = writePlainFrame(channelNumber, fragments, fragmentCount, dlc);
+            }
+        }
+
+        return status;
+    }
+
+    /**
+     * Build a single frame out of payload fragments and write it to the Stream or the TX staging buffer.
+     * The checksum is computed across the fragments, which are then written or buffered without assembling
+     * a contiguous frame first.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] fragments Payload fragments, in order.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @param[in] dlc Sum of the fragment lengths.
+     * @returns Whether the frame has been sent, queued or rejected because the TX queue is full.
+     */
+    SendStatus writePlainFrame(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount, uint8_t dlc)
+    {
+        const uint16_t             frameLength = FRAME_HEADER_LEN + dlc;
+        typename tIntegrity::State state       = tIntegrity::begin();
+        bool                       isAccepted  = false;
+        uint8_t                    header[FRAME_HEADER_LEN];
+        IoVector                   vectors[1U + MAX_TX_FRAGMENTS];
+
+        header[CHANNEL_FIELD_IDX] = channelNumber;
+        header[DLC_FIELD_IDX]     = dlc;
+        vectors[0U]               = IoVector(header, FRAME_HEADER_LEN);
+        state                     = tIntegrity::update(state, header, (CHANNEL_LEN + DLC_LEN));
+
+        for (uint8_t idx = 0U; idx < fragmentCount; idx++)
+        {
+            vectors[1U + idx] = fragments[idx];
+            state = tIntegrity::update(state, static_cast<const uint8_t*>(fragments[idx].m_data),
+                                       fragments[idx].m_length);
+        }
+
+        tIntegrity::finish(state, &header[CHECKSUM_FIELD_IDX]);
+
+        if (frameLength > m_txBuffer.getFreeSpace())
+        {
+            /* Make room for the frame. */
+            (void)flushTxBuffer();
+        }
+
+        if (0U == m_txBuffer.size())
+        {
+            m_txPendingSince = m_currentTimestamp;
+        }
+
+        isAccepted = m_txBuffer.write(m_stream, m_vectoredWriter, vectors, (1U + fragmentCount), frameLength,
+                                      getWritableBytes());
+
+        if (true == isAccepted)
+        {
+            prioritizeFrame(getTxPriority(channelNumber), frameLength);
+        }
+
+        return completeFrame(isAccepted);
+    }
+
+    /**
+     * Get the rate limit of a TX channel.
+     * @param[in] channelNumber Number of the TX channel.
+     * @returns Rate limit of the channel, or nullptr if not limited.
+     */
+    TxRateLimit* getTxRateLimit(uint8_t channelNumber) const
+    {
+        TxRateLimit* rateLimit = nullptr;
+
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber))
+        {
+            rateLimit = m_txRateLimits[channelNumber - 1U];
+        }
+
+        return rateLimit;
+    }
+
+    /**
+     * Send the frames deferred by rate limits, once their budget allows it.
+     * A deferred frame stays deferred if the TX queue is full.
+     */
+    void sendDeferredFrames()
+    {
+        if (true == m_isSynced)
+        {
+            for (uint8_t idx = 0U; idx < tMaxChannels; idx++)
+            {
+                TxRateLimit* rateLimit = m_txRateLimits[idx];
+
+                if ((nullptr != rateLimit) && (true == rateLimit->hasDeferredFrame()))
+                {
+                    const uint8_t dlc = rateLimit->getDeferredLength();
+
+                    if (true == rateLimit->isAvailable(m_currentTimestamp, (FRAME_HEADER_LEN + dlc)))
+                    {
+                        IoVector fragment(rateLimit->getDeferredPayload(), dlc);
+
+                        if (true == isSendAccepted(queueFrame((idx + 1U), &fragment, 1U, dlc)))
+                        {
+                            rateLimit->consume(FRAME_HEADER_LEN + dlc);
+                            rateLimit->clearDeferredFrame();
+                        }
                     }
                 }
             }
@@ -407,234 +1772,605 @@ private:
     }
 
     /**
-     * Callback for the Control Channel
-     * @param[in] payload Payload of received frame.
-     * @param[in] payloadSize Length of Payload
+     * Send the pending frames of the TxSource, in order.
+     * Frames stay pending while not synced, and if the TX queue is full, so the order is kept.
+     * Other frames not accepted, e.g. with an invalid channel, are released.
+     */
+    void sendTxSourceFrames()
+    {
+        if ((true == m_isSynced) && (nullptr != m_txSource))
+        {
+            uint8_t        channelNumber = 0U;
+            const uint8_t* payload       = nullptr;
+            uint8_t        payloadSize   = 0U;
+
+            while ((true == m_txSource->front(channelNumber, payload, payloadSize)) &&
+                   (SEND_QUEUE_FULL != sendFrame(channelNumber, payload, payloadSize)))
+            {
+                m_txSource->pop();
+            }
+        }
+    }
+
+    /**
+     * Check if a frame of a TX channel is within its rate limit. Frames keep their order behind a deferred frame.
+     * @param[in] channelNumber Number of the TX channel.
+     * @param[in] frameLength Length of the complete frame.
+     * @returns true if the frame can be sent, otherwise false.
+     */
+    bool isTxRateAvailable(uint8_t channelNumber, uint16_t frameLength)
+    {
+        TxRateLimit* rateLimit = getTxRateLimit(channelNumber);
+
+        return ((nullptr == rateLimit) || ((false == rateLimit->hasDeferredFrame()) &&
+                                           (true == rateLimit->isAvailable(m_currentTimestamp, frameLength))));
+    }
+
+    /**
+     * Write a frame of a conflated channel. It replaces the queued frame of the channel, if any.
+     * A queued frame of the same length is overwritten in place. Otherwise, it is removed and the new frame is
+     * appended.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] fragments Payload fragments, in order.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @param[in] dlc Sum of the fragment lengths.
+     * @returns Whether the frame has been sent, queued or rejected because the TX queue is full.
+     */
+    SendStatus writeConflatedFrame(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount,
+                                   uint8_t dlc)
+    {
+        SendStatus status      = SEND_QUEUE_FULL;
+        uint8_t*   queuedFrame = getConflatedFrame(channelNumber);
+
+        if ((nullptr != queuedFrame) && (dlc == queuedFrame[DLC_FIELD_IDX]))
+        {
+            (void)copyIoVectors(&queuedFrame[FRAME_HEADER_LEN], fragments, fragmentCount, 0U, dlc);
+            checksum(queuedFrame, &queuedFrame[CHECKSUM_FIELD_IDX]);
+            m_txStatistics.m_supersededFrames++;
+
+            status = completeFrame(true);
+        }
+        else
+        {
+            eraseConflatedFrame(channelNumber);
+            closeSuperFrame();
+
+            status = writePlainFrame(channelNumber, fragments, fragmentCount, dlc);
+            trackConflatedFrame(channelNumber, status);
+        }
+
+        return status;
+    }
+
+    /**
+     * Get the queued frame of a conflated channel.
+     * @param[in] channelNumber Number of the TX channel.
+     * @returns Pointer to the frame in the TX staging buffer, or nullptr if none or if it is already being written.
+     */
+    uint8_t* getConflatedFrame(uint8_t channelNumber)
+    {
+        uint8_t* frame = nullptr;
+
+        if (true == isChannelInMask(m_pendingConflatedFrames, channelNumber))
+        {
+            /* Bytes are written in order. If the header has not been written, the frame has not been either. */
+            frame = m_txBuffer.getUnsent(m_conflatedFramePositions[channelNumber - 1U], FRAME_HEADER_LEN);
+
+            if (nullptr == frame)
+            {
+                setChannelInMask(m_pendingConflatedFrames, channelNumber, false);
+            }
+        }
+
+        return frame;
+    }
+
+    /**
+     * Remove the queued frame of a conflated channel from the TX staging buffer, if any.
+     * The following frames move up.
+     * @param[in] channelNumber Number of the TX channel.
+     */
+    void eraseConflatedFrame(uint8_t channelNumber)
+    {
+        uint8_t* frame = getConflatedFrame(channelNumber);
+
+        if (nullptr != frame)
+        {
+            const uint32_t position    = m_conflatedFramePositions[channelNumber - 1U];
+            const uint16_t frameLength = FRAME_HEADER_LEN + frame[DLC_FIELD_IDX];
+
+            /* The open super-frame must not move. */
+            closeSuperFrame();
+            m_txBuffer.erase(position, frameLength);
+            setChannelInMask(m_pendingConflatedFrames, channelNumber, false);
+            m_txStatistics.m_supersededFrames++;
+
+            for (uint8_t idx = 0U; idx < tMaxChannels; idx++)
+            {
+                if (true == isPositionBefore(position, m_conflatedFramePositions[idx]))
+                {
+                    m_conflatedFramePositions[idx] -= frameLength;
+                }
+            }
+
+            for (uint8_t idx = 0U; idx < TX_PRIORITY_CLASSES; idx++)
+            {
+                if (true == isPositionBefore(position, m_txClassTails[idx]))
+                {
+                    m_txClassTails[idx] -= frameLength;
+                }
+            }
+
+            if (true == isPositionBefore(position, m_txLockedEnd))
+            {
+                m_txLockedEnd -= frameLength;
+            }
+
+            if (true == isPositionBefore(position, m_lastQueuedFramePosition))
+            {
+                m_lastQueuedFramePosition -= frameLength;
+            }
+        }
+    }
+
+    /**
+     * Remember the last queued frame of the TX staging buffer as queued frame of a conflated channel.
+     * @param[in] channelNumber Number of the TX channel.
+     * @param[in] status Result of sending the frame. Only a queued frame is remembered.
+     */
+    void trackConflatedFrame(uint8_t channelNumber, SendStatus status)
+    {
+        m_conflatedFramePositions[channelNumber - 1U] = m_lastQueuedFramePosition;
+        setChannelInMask(m_pendingConflatedFrames, channelNumber, (SEND_QUEUED == status));
+    }
+
+    /**
+     * Check if a channel is set in a channel bitmask.
+     * @param[in] mask Bitmask with one bit per data channel. Bit 0 of the first byte is channel 1.
+     * @param[in] channelNumber Number of the channel.
+     * @returns true if the bit of the channel is set, otherwise false.
+     */
+    static bool isChannelInMask(const uint8_t* mask, uint8_t channelNumber)
+    {
+        bool isSet = false;
+
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber))
+        {
+            uint8_t channelIdx = channelNumber - 1U;
+
+            isSet = (0U != (mask[channelIdx / 8U] & (1U << (channelIdx % 8U))));
+        }
+
+        return isSet;
+    }
+
+    /**
+     * Set or clear a channel in a channel bitmask.
+     * @param[in] mask Bitmask with one bit per data channel. Bit 0 of the first byte is channel 1.
+     * @param[in] channelNumber Number of the channel. Invalid channels are ignored.
+     * @param[in] isSet Set or clear the bit of the channel.
+     */
+    static void setChannelInMask(uint8_t* mask, uint8_t channelNumber, bool isSet)
+    {
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber))
+        {
+            uint8_t channelIdx = channelNumber - 1U;
+            uint8_t bit        = static_cast<uint8_t>(1U << (channelIdx % 8U));
+
+            if (true == isSet)
+            {
+                mask[channelIdx / 8U] |= bit;
+            }
+            else
+            {
+                mask[channelIdx / 8U] &= static_cast<uint8_t>(~bit);
+            }
+        }
+    }
+
+    /**
+     * Check if a frame is suppressed by the subscription filter. Suppressed frames are counted.
+     * @param[in] channelNumber Channel to send frame to.
+     * @returns true if the frame must not be sent, otherwise false.
+     */
+    bool isTxSuppressed(uint8_t channelNumber)
+    {
+        bool isSuppressed = false;
+
+        if ((true == m_isTxSubscriptionFilterEnabled) && (CONTROL_CHANNEL_NUMBER != channelNumber) &&
+            (false == isTxChannelSubscribed(channelNumber)))
+        {
+            m_txStatistics.m_suppressedFrames++;
+            isSuppressed = true;
+        }
+
+        return isSuppressed;
+    }
+
+    /**
+     * Check if a frame is packed into a super-frame.
+     * @param[in] channelNumber Channel to send frame to.
+     * @param[in] dlc Length of the payload.
+     * @returns true if the frame is sent as record of a super-frame, otherwise false.
+     */
+    bool isSuperFrameRecord(uint8_t channelNumber, uint8_t dlc) const
+    {
+        return ((true == m_isSuperFrameEnabled) && (CONTROL_CHANNEL_NUMBER != channelNumber) &&
+                ((SUPER_FRAME_RECORD_HEADER_LEN + dlc) <= tMaxDataLen));
+    }
+
+    /**
+     * Append a record to the open super-frame in the TX staging buffer.
+     * A new super-frame is opened if there is none, or if the record does not fit into it.
+     * @param[in] channelNumber Channel of the record.
+     * @param[in] fragments Payload fragments, in order.
+     * @param[in] fragmentCount Number of fragments. Must not be greater than MAX_TX_FRAGMENTS.
+     * @param[in] dlc Sum of the fragment lengths.
+     * @returns true if the record has been appended, otherwise false.
+     */
+    bool appendSuperFrameRecord(uint8_t channelNumber, const IoVector* fragments, uint8_t fragmentCount, uint8_t dlc)
+    {
+        const uint16_t   recordLength = SUPER_FRAME_RECORD_HEADER_LEN + dlc;
+        const TxPriority priority     = getTxPriority(channelNumber);
+        bool             isAppended   = false;
+        uint8_t*         record       = nullptr;
+
+        if ((nullptr != m_superFrame) &&
+            ((m_superFramePriority != priority) || ((m_superFrame[DLC_FIELD_IDX] + recordLength) > tMaxDataLen) ||
+             (recordLength > m_txBuffer.getFreeSpace())))
+        {
+            /* Record does not belong to or does not fit into the open super-frame. */
+            closeSuperFrame();
+        }
+
+        if (nullptr == m_superFrame)
+        {
+            openSuperFrame(priority, recordLength);
+        }
+
+        if (nullptr != m_superFrame)
+        {
+            record = m_txBuffer.claim(recordLength);
+        }
+
+        if (nullptr != record)
+        {
+            record[CHANNEL_FIELD_IDX] = channelNumber;
+            record[DLC_FIELD_IDX]     = dlc;
+            (void)copyIoVectors(&record[SUPER_FRAME_RECORD_HEADER_LEN], fragments, fragmentCount, 0U, dlc);
+            (void)m_txBuffer.commit(m_stream, m_vectoredWriter, recordLength, UINT32_MAX);
+
+            m_superFrame[DLC_FIELD_IDX] += recordLength;
+            m_superFrameRecords++;
+            isAppended = true;
+        }
+
+        return isAppended;
+    }
+
+    /**
+     * Open a super-frame at the end of the TX staging buffer.
+     * @param[in] priority Priority class of the records of the super-frame.
+     * @param[in] recordLength Length of the first record, which must fit into the buffer as well.
+     */
+    void openSuperFrame(TxPriority priority, uint16_t recordLength)
+    {
+        const uint16_t length = FRAME_HEADER_LEN + recordLength;
+
+        if (length > m_txBuffer.getFreeSpace())
+        {
+            /* Make room for the frame. */
+            (void)flushTxBuffer();
+        }
+
+        if (length <= m_txBuffer.getFreeSpace())
+        {
+            if (0U == m_txBuffer.size())
+            {
+                m_txPendingSince = m_currentTimestamp;
+            }
+
+            m_superFrame = m_txBuffer.claim(FRAME_HEADER_LEN);
+            (void)m_txBuffer.commit(m_stream, m_vectoredWriter, FRAME_HEADER_LEN, UINT32_MAX);
+
+            m_superFrame[CHANNEL_FIELD_IDX] = SUPER_FRAME_CHANNEL_NUMBER;
+            m_superFrame[DLC_FIELD_IDX]     = 0U;
+            m_superFrameRecords             = 0U;
+            m_superFramePriority            = priority;
+
+            markTxClassPending(priority);
+        }
+    }
+
+    /**
+     * Close the open super-frame by filling in its checksum. A single record is turned into a normal frame.
+     * The frame is then placed according to its priority class.
+     */
+    void closeSuperFrame()
+    {
+        if (nullptr != m_superFrame)
+        {
+            if (1U == m_superFrameRecords)
+            {
+                uint8_t* record = &m_superFrame[FRAME_HEADER_LEN];
+                uint8_t  dlc    = record[DLC_FIELD_IDX];
+
+                m_superFrame[CHANNEL_FIELD_IDX] = record[CHANNEL_FIELD_IDX];
+                m_superFrame[DLC_FIELD_IDX]     = dlc;
+                memmove(record, &record[SUPER_FRAME_RECORD_HEADER_LEN], dlc);
+                m_txBuffer.truncate(SUPER_FRAME_RECORD_HEADER_LEN);
+            }
+
+            checksum(m_superFrame, &m_superFrame[CHECKSUM_FIELD_IDX]);
+            prioritizeFrame(m_superFramePriority, (FRAME_HEADER_LEN + m_superFrame[DLC_FIELD_IDX]));
+            m_superFrame        = nullptr;
+            m_superFrameRecords = 0U;
+        }
+    }
+
+    /**
+     * Dispatch the records of a super-frame to their channels.
+     * Unpacking stops at the first malformed record.
+     * @param[in] payload Payload of the super-frame.
+     * @param[in] dlc Length of the payload.
+     */
+    void dispatchSuperFrame(const uint8_t* payload, uint8_t dlc)
+    {
+        uint16_t idx = 0U;
+
+        while ((idx + SUPER_FRAME_RECORD_HEADER_LEN) <= dlc)
+        {
+            const uint8_t* record        = &payload[idx];
+            uint8_t        channelNumber = record[CHANNEL_FIELD_IDX];
+            uint8_t        recordLength  = record[DLC_FIELD_IDX];
+
+            idx += SUPER_FRAME_RECORD_HEADER_LEN + recordLength;
+
+            if ((0U == recordLength) || (dlc < idx))
+            {
+                /* Malformed record. */
+                break;
+            }
+
+            if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber) &&
+                (nullptr != m_rxChannels[channelNumber - 1U].m_callback))
+            {
+                m_rxChannels[channelNumber - 1U].m_callback(&record[SUPER_FRAME_RECORD_HEADER_LEN], recordLength,
+                                                            m_userData);
+            }
+        }
+    }
+
+    /**
+     * Flush the TX staging buffer after a frame has been written to it, if required.
+     * Buffered frames are written right away, unless sent during process() or a batch,
+     * or the size threshold is reached.
+     * @param[in] isAccepted Whether the frame has been accepted by the TX staging buffer or the Stream.
+     * @returns Whether the frame has been sent, queued or rejected because the TX queue is full.
      */
-    void callbackControlChannel(const uint8_t* payload, const uint8_t payloadSize)
+    SendStatus completeFrame(bool isAccepted)
     {
-        if ((nullptr != payload) && (CONTROL_CHANNEL_PAYLOAD_LENGTH == payloadSize))
-        {
-            const ControlChannelPayload* parsedPayload = reinterpret_cast<const ControlChannelPayload*>(payload);
+        SendStatus status = SEND_QUEUE_FULL;
 
-            switch (parsedPayload->commandByte)
+        if (true == isAccepted)
+        {
+            if (((false == m_isTxBatchActive) && (false == m_isProcessing)) ||
+                (m_txFlushThreshold <= m_txBuffer.size()))
             {
-            case COMMANDS::SYNC:
-                cmdSYNC(parsedPayload->timestamp);
-                break;
+                (void)flushTxBuffer();
+            }
 
-            case COMMANDS::SYNC_RSP:
-                cmdSYNC_RSP(parsedPayload->timestamp);
-                break;
+            /* The frame is the last one in the buffer. It is sent once the buffer is empty. */
+            status = (0U == m_txBuffer.size()) ? SEND_SENT : SEND_QUEUED;
+        }
 
-            case COMMANDS::SCRB:
-                cmdSCRB(parsedPayload->channelName);
-                break;
+        return status;
+    }
 
-            case COMMANDS::SCRB_RSP:
-                cmdSCRB_RSP(parsedPayload->channelName, parsedPayload->channelNumber);
-                break;
+    /**
+     * Write the TX staging buffer to the Stream.
+     * With TX staging buffer, nothing is written while a frame is claimed, as the claimed frame must not move.
+     * Without, the claimed frame is a separate staging frame, so the remainder of a partially written frame is
+     * written anyway.
+     * @returns true if the staging buffer is empty afterwards, otherwise false.
+     */
+    bool flushTxBuffer()
+    {
+        bool isEmpty = false;
 
-            default:
-                break;
-            }
+        if ((0U == tTxBufferSize) || (nullptr == m_claimedFrame))
+        {
+            const uint32_t writableBytes = getWritableBytes();
+
+            closeSuperFrame();
+            lockTxFrames(writableBytes);
+            isEmpty = m_txBuffer.flush(m_stream, writableBytes);
+            updateTxQueueingDelays();
         }
+
+        return isEmpty;
     }
 
     /**
-     * Receive and process RX Data.
+     * Get the priority class of a TX channel.
+     * @param[in] channelNumber Number of the TX channel.
+     * @returns Priority class of the channel. TX_PRIORITY_CONTROL for the Control Channel.
      */
-    void processRxData()
+    TxPriority getTxPriority(uint8_t channelNumber) const
     {
-        uint8_t expectedBytes   = 0;
-        uint8_t dlc             = 0;
-        bool    expectingHeader = false;
+        TxPriority priority = TX_PRIORITY_CONTROL;
 
-        /* Determine how many bytes to read. */
-        if (HEADER_LEN > m_receivedBytes)
+        if ((CONTROL_CHANNEL_NUMBER != channelNumber) && (tMaxChannels >= channelNumber))
         {
-            /* Header must be read. */
-            expectedBytes   = (HEADER_LEN - m_receivedBytes);
-            expectingHeader = true;
+            priority = m_txChannels[channelNumber - 1U].m_priority;
         }
-        else
+
+        return priority;
+    }
+
+    /**
+     * Move the last frame of the TX staging buffer behind the queued frames of its own and higher priority classes,
+     * ahead of the frames of lower classes. Frames which are being written are not overtaken.
+     * @param[in] priority Priority class of the frame.
+     * @param[in] frameLength Length of the frame.
+     */
+    void prioritizeFrame(TxPriority priority, uint16_t frameLength)
+    {
+        if (0U != tTxBufferSize)
         {
-            /* Header has been read. Get DLC of Rx Channel using Header. */
-            dlc = m_receiveFrame.fields.header.headerFields.m_dlc;
+            uint32_t position = getLaterPosition(getTxHeadPosition(), m_txLockedEnd);
 
-            /* DLC = 0 means that the channel does not exist. */
-            if ((0U != dlc) && (MAX_RX_ATTEMPTS >= m_rxAttempts))
+            for (uint8_t idx = 0U; idx <= priority; idx++)
             {
-                expectedBytes = (dlc - (m_receivedBytes - HEADER_LEN));
-                m_rxAttempts++;
+                position = getLaterPosition(position, m_txClassTails[idx]);
             }
-        }
 
-        /* Are we expecting to read anything? */
-        if (0U != expectedBytes)
-        {
-            /* Read the required amount of bytes, if available. */
-            if (expectedBytes <= m_stream.available())
+            m_txBuffer.moveTail(position, frameLength);
+
+            for (uint8_t idx = 0U; idx < tMaxChannels; idx++)
             {
-                m_receivedBytes += m_stream.readBytes(&m_receiveFrame.raw[m_receivedBytes], expectedBytes);
+                if (false == isPositionBefore(m_conflatedFramePositions[idx], position))
+                {
+                    m_conflatedFramePositions[idx] += frameLength;
+                }
             }
 
-            if ((HEADER_LEN == m_receivedBytes) && (true == expectingHeader))
+            /* Lower classes follow the frame, even if they have no queued frames. */
+            for (uint8_t idx = priority; idx < TX_PRIORITY_CLASSES; idx++)
             {
-                /* Header has been read. Get DLC of Rx Channel using Header. */
-                dlc = m_receiveFrame.fields.header.headerFields.m_dlc;
+                m_txClassTails[idx] = getLaterPosition(m_txClassTails[idx], position) + frameLength;
+            }
 
-                /* DLC = 0 means that the channel does not exist. */
-                if ((0U != dlc) && (MAX_RX_ATTEMPTS >= m_rxAttempts))
-                {
-                    expectedBytes = (dlc - (m_receivedBytes - HEADER_LEN));
-                    m_rxAttempts++;
-                }
+            m_lastQueuedFramePosition = position;
+            markTxClassPending(priority);
+        }
+    }
 
-                if (0U != expectedBytes)
-                {
-                    if (expectedBytes <= m_stream.available())
-                    {
-                        m_receivedBytes += m_stream.readBytes(&m_receiveFrame.raw[m_receivedBytes], expectedBytes);
-                    }
-                }
+    /**
+     * Lock the frames of the TX staging buffer which the next flush writes, at least partially.
+     * A frame must be written completely once it is started, so no frame may be moved ahead of it.
+     * If the Stream accepts less bytes than possible, some unwritten frames stay locked.
+     * @param[in] maxBytes Maximum number of bytes to write with the next flush.
+     */
+    void lockTxFrames(uint32_t maxBytes)
+    {
+        if (0U != tTxBufferSize)
+        {
+            const uint32_t headPosition = getTxHeadPosition();
+            uint32_t       writeEnd     = m_txBuffer.getTailPosition();
+            uint32_t       frameEnd     = getLaterPosition(headPosition, m_txLockedEnd);
+
+            if (maxBytes < m_txBuffer.size())
+            {
+                writeEnd = headPosition + maxBytes;
             }
 
-            /* Frame has been received. */
-            if ((0U != dlc) && ((HEADER_LEN + dlc) == m_receivedBytes))
+            while (true == isPositionBefore(frameEnd, writeEnd))
             {
-                if (true == isFrameValid(m_receiveFrame))
-                {
-                    uint8_t channelArrayIndex = (m_receiveFrame.fields.header.headerFields.m_channel - 1U);
+                const uint8_t* header = m_txBuffer.getUnsent(frameEnd, FRAME_HEADER_LEN);
 
-                    /* Differenciate between Control and Data Channels. */
-                    if (CONTROL_CHANNEL_NUMBER == m_receiveFrame.fields.header.headerFields.m_channel)
-                    {
-                        callbackControlChannel(m_receiveFrame.fields.payload.m_data, CONTROL_CHANNEL_PAYLOAD_LENGTH);
-                    }
-                    else if (nullptr != m_rxCallbacks[channelArrayIndex])
-                    {
-                        /* Callback */
-                        m_rxCallbacks[channelArrayIndex](m_receiveFrame.fields.payload.m_data, dlc, m_userData);
-                    }
+                if (nullptr == header)
+                {
+                    /* Not at a frame boundary. */
+                    break;
                 }
 
-                /* Frame received. Cleaning! */
-                clearLocalRxBuffers();
+                frameEnd += FRAME_HEADER_LEN + header[DLC_FIELD_IDX];
             }
-        }
-        else
-        {
-            /* Invalid header. Delete Frame. */
-            clearLocalRxBuffers();
+
+            m_txLockedEnd = frameEnd;
         }
     }
 
     /**
-     * Clear RX Buffer and counters.
+     * Remember when a priority class got queued frames, if it had none.
+     * @param[in] priority Priority class of the queued frame.
      */
-    void clearLocalRxBuffers()
+    void markTxClassPending(TxPriority priority)
     {
-        m_receivedBytes = 0U;
-        m_rxAttempts    = 0U;
+        const uint8_t classBit = static_cast<uint8_t>(1U << priority);
+
+        if (0U == (m_pendingTxClasses & classBit))
+        {
+            m_pendingTxClasses              |= classBit;
+            m_txClassPendingSince[priority]  = m_currentTimestamp;
+        }
     }
 
     /**
-     * Periodic heartbeat.
-     * Sends SYNC Command depending on the current Sync state.
-     * @param[in] currentTimestamp Time in milliseconds.
+     * Update the worst-case queueing delay of the priority classes whose frames have been written completely.
      */
-    void heartbeat(const uint32_t currentTimestamp)
+    void updateTxQueueingDelays()
     {
-        uint32_t heartbeatPeriod = HEATBEAT_PERIOD_UNSYNCED;
+        const uint32_t headPosition = getTxHeadPosition();
 
-        if (true == m_isSynced)
+        for (uint8_t idx = 0U; idx < TX_PRIORITY_CLASSES; idx++)
         {
-            heartbeatPeriod = HEATBEAT_PERIOD_SYNCED;
-        }
+            const uint8_t classBit = static_cast<uint8_t>(1U << idx);
 
-        if ((currentTimestamp - m_lastSyncCommand) >= heartbeatPeriod)
-        {
-            /* Timeout. */
-            if (m_lastSyncCommand != m_lastSyncResponse)
+            if ((0U != (m_pendingTxClasses & classBit)) &&
+                (false == isPositionBefore(headPosition, m_txClassTails[idx])))
             {
-                setSyncedState(false);
-            }
+                uint32_t delay = m_currentTimestamp - m_txClassPendingSince[idx];
 
-            /* Send SYNC Command. */
-            ControlChannelPayload payload;
-            payload.commandByte = COMMANDS::SYNC;
-            payload.timestamp   = currentTimestamp;
+                if (m_txStatistics.m_maxQueueingDelay[idx] < delay)
+                {
+                    m_txStatistics.m_maxQueueingDelay[idx] = delay;
+                }
 
-            if (true == send(CONTROL_CHANNEL_NUMBER, &payload, sizeof(ControlChannelPayload)))
-            {
-                m_lastSyncCommand = currentTimestamp;
+                m_pendingTxClasses &= static_cast<uint8_t>(~classBit);
             }
         }
     }
 
     /**
-     * Subscribe to any pending Channels if synced to server.
+     * Get the position of the first unwritten byte of the TX staging buffer in its byte stream.
+     * @returns Position of the head of the buffer.
      */
-    void managePendingSubscriptions()
+    uint32_t getTxHeadPosition() const
     {
-        if ((true == m_isSynced) && (0U < m_numberOfPendingChannels))
-        {
-            for (uint8_t idx = 0; idx < tMaxChannels; idx++)
-            {
-                if (nullptr != m_pendingSuscribeChannels[idx].m_callback)
-                {
-                    /* Suscribe to channel. */
-                    /* Using strnlen in case the name is not null-terminated. */
-                    uint8_t nameLength = strnlen(m_pendingSuscribeChannels[idx].m_name, CHANNEL_NAME_MAX_LEN);
-                    ControlChannelPayload output;
-                    output.commandByte = COMMANDS::SCRB;
-                    memcpy(output.channelName, m_pendingSuscribeChannels[idx].m_name, nameLength);
-
-                    if (false == send(CONTROL_CHANNEL_NUMBER, &output, sizeof(ControlChannelPayload)))
-                    {
-                        /* Out-of-Sync on failed send. */
-                        setSyncedState(false);
-                        break;
-                    }
-                }
-            }
-        }
+        return (m_txBuffer.getTailPosition() - m_txBuffer.size());
     }
 
     /**
-     * Send a frame with the selected bytes.
-     * @param[in] channelNumber Channel to send frame to.
-     * @param[in] payload Byte buffer to be sent.
-     * @param[in] payloadSize Amount of bytes to send.
-     * @returns If payload succesfully sent, returns true. Otherwise, false.
+     * Check if a position in the byte stream of the TX staging buffer is before another one.
+     * Positions wrap around, so their distance is compared.
+     * @param[in] position Position to check.
+     * @param[in] other Position to compare with.
+     * @returns true if position is before other, otherwise false.
      */
-    bool send(uint8_t channelNumber, const void* payload, uint8_t payloadSize) const
+    static bool isPositionBefore(uint32_t position, uint32_t other)
     {
-        bool    frameSent  = false;
-        uint8_t channelDLC = getTxChannelDLC(channelNumber);
+        return (0 < static_cast<int32_t>(other - position));
+    }
 
-        if ((nullptr != payload) && (channelDLC == payloadSize) &&
-            (true == m_isSynced || (CONTROL_CHANNEL_NUMBER == channelNumber)))
-        {
-            const uint8_t frameLength  = HEADER_LEN + channelDLC;
-            uint8_t       writtenBytes = 0;
-            Frame         newFrame;
+    /**
+     * Get the later of two positions in the byte stream of the TX staging buffer.
+     * @param[in] position First position.
+     * @param[in] other Second position.
+     * @returns The later position.
+     */
+    static uint32_t getLaterPosition(uint32_t position, uint32_t other)
+    {
+        return (true == isPositionBefore(position, other)) ? other : position;
+    }
 
-            newFrame.fields.header.headerFields.m_channel = channelNumber;
-            newFrame.fields.header.headerFields.m_dlc     = channelDLC;
-            memcpy(newFrame.fields.payload.m_data, payload, channelDLC);
-            newFrame.fields.header.headerFields.m_checksum = checksum(newFrame);
+    /**
+     * Get the number of bytes that can be written to the Stream without blocking.
+     * @returns Number of bytes. Unlimited if back-pressure is disabled.
+     */
+    uint32_t getWritableBytes() const
+    {
+        uint32_t writableBytes = UINT32_MAX;
 
-            writtenBytes = m_stream.write(newFrame.raw, frameLength);
+        if (true == m_isTxBackPressureEnabled)
+        {
+            int availableBytes = m_stream.availableForWrite();
 
-            if (frameLength == writtenBytes)
-            {
-                frameSent = true;
-            }
+            writableBytes = (0 < availableBytes) ? static_cast<uint32_t>(availableBytes) : 0U;
         }
 
-        return frameSent;
+        return writableBytes;
     }
 
     /**
@@ -642,10 +2378,14 @@ private:
      * @param[in] frame Frame to be checked.
      * @returns true if the Frame's checksum is correct.
      */
-    bool isFrameValid(const Frame& frame)
+    bool isFrameValid(const uint8_t* frame) const
     {
+        uint8_t expectedChecksum[tIntegrity::LENGTH];
+
+        checksum(frame, expectedChecksum);
+
         /* Frame is valid when both checksums are the same. */
-        return (checksum(frame) == frame.fields.header.headerFields.m_checksum);
+        return (0 == memcmp(expectedChecksum, &frame[CHECKSUM_FIELD_IDX], tIntegrity::LENGTH));
     }
 
     /**
@@ -676,21 +2416,55 @@ private:
     }
 
     /**
-     * Performs the checksum of a Frame.
+     * Performs the checksum of a Frame using the integrity policy.
+     * It covers the channel, the DLC and the payload of the frame.
      * @param[in] frame Frame to calculate checksum
-     * @returns checksum value
+     * @param[out] checksum Checksum field of tIntegrity::LENGTH bytes.
+     */
+    void checksum(const uint8_t* frame, uint8_t* checksum) const
+    {
+        typename tIntegrity::State state = tIntegrity::begin();
+
+        state = tIntegrity::update(state, &frame[CHANNEL_FIELD_IDX], (CHANNEL_LEN + DLC_LEN));
+        state = tIntegrity::update(state, &frame[FRAME_HEADER_LEN], frame[DLC_FIELD_IDX]);
+        tIntegrity::finish(state, checksum);
+    }
+
+    /**
+     * Encode the payload limit of the server for SYNC and SYNC_RSP.
+     * The default limit is advertised as 0, so the frames are the same as for peers not advertising a limit.
+     * @returns Value of the channel number field.
+     */
+    static uint8_t encodePayloadLimit()
+    {
+        return (MAX_DATA_LEN == tMaxDataLen) ? 0U : tMaxDataLen;
+    }
+
+    /**
+     * Decode the payload limit advertised in SYNC and SYNC_RSP.
+     * @param[in] rcvPayloadLimit Value of the channel number field.
+     * @returns Payload limit of the client.
+     */
+    static uint8_t decodePayloadLimit(uint8_t rcvPayloadLimit)
+    {
+        return (0U == rcvPayloadLimit) ? MAX_DATA_LEN : rcvPayloadLimit;
+    }
+
+    /**
+     * Get the generation for a newly assigned channel slot.
+     * @returns Generation, never 0.
      */
-    uint8_t checksum(const Frame& frame) const
+    uint8_t nextGeneration()
     {
-        uint32_t sum = frame.fields.header.headerFields.m_channel;
-        sum += frame.fields.header.headerFields.m_dlc;
+        m_lastGeneration++;
 
-        for (size_t idx = 0U; idx < frame.fields.header.headerFields.m_dlc; idx++)
+        /* Generation 0 is reserved for unresolved handles. */
+        if (0U == m_lastGeneration)
         {
-            sum += frame.fields.payload.m_data[idx];
+            m_lastGeneration++;
         }
 
-        return (sum % UINT8_MAX);
+        return m_lastGeneration;
     }
 
     /**
@@ -728,10 +2502,10 @@ private:
     Channel m_txChannels[tMaxChannels];
 
     /**
-     * Array of rx channel Callbacks.
+     * Array of rx Data Channels, indexed by the channel number of the remote.
      * Server is subscribed to these channels.
      */
-    ChannelCallback m_rxCallbacks[tMaxChannels];
+    Channel m_rxChannels[tMaxChannels];
 
     /**
      * Array of pending rx Data Channels.
@@ -754,26 +2528,177 @@ private:
      */
     uint32_t m_lastSyncResponse;
 
+    /**
+     * Payload limit advertised by the client. 0 if not received yet.
+     */
+    uint8_t m_remoteMaxDataLength;
+
     /**
      * Stream for input and output of data.
      */
     Stream& m_stream;
 
     /**
-     * Frame buffer for received Bytes.
-     * Allows direct access to Frame Fields once bytes are in the raw buffer.
+     * Optional source of received bytes, replacing the Stream for reading. nullptr if none.
      */
-    Frame m_receiveFrame;
+    RxSource* m_rxSource;
 
     /**
-     * Number of bytes that have been correctly received.
+     * Buffer for received Bytes.
      */
-    uint8_t m_receivedBytes;
+    SerialMuxProtRxBuffer<tRxBufferSize, FRAME_MAX_LEN> m_rxBuffer;
 
     /**
      * Number of attempts performed at receiving a Frame.
      */
-    uint8_t m_rxAttempts;
+    uint16_t m_rxAttempts;
+
+    /**
+     * Number of bytes discarded by the currently running resynchronization.
+     */
+    uint32_t m_rxResyncDiscardedBytes;
+
+    /**
+     * Statistics of the RX path.
+     */
+    RxStatistics m_rxStatistics;
+
+    /**
+     * Staging buffer for frames to be sent.
+     */
+    SerialMuxProtTxBuffer<tTxBufferSize, FRAME_MAX_LEN> m_txBuffer;
+
+    /**
+     * Frames are collected until flush() is called.
+     */
+    bool m_isTxBatchActive;
+
+    /**
+     * Frames are collected until the end of process().
+     */
+    bool m_isProcessing;
+
+    /**
+     * Frame reserved by claim(), or nullptr if none.
+     */
+    uint8_t* m_claimedFrame;
+
+    /**
+     * Optional VectoredWriter of the Stream.
+     */
+    VectoredWriter* m_vectoredWriter;
+
+    /**
+     * Only write as many bytes as the Stream accepts without blocking.
+     */
+    bool m_isTxBackPressureEnabled;
+
+    /**
+     * Pack data frames sent in the same cycle into super-frames.
+     */
+    bool m_isSuperFrameEnabled;
+
+    /**
+     * Open super-frame at the end of the TX staging buffer, or nullptr if none.
+     */
+    uint8_t* m_superFrame;
+
+    /**
+     * Number of records in the open super-frame.
+     */
+    uint8_t m_superFrameRecords;
+
+    /**
+     * Priority class of the open super-frame.
+     */
+    TxPriority m_superFramePriority;
+
+    /**
+     * Only send frames on channels the remote is subscribed to.
+     */
+    bool m_isTxSubscriptionFilterEnabled;
+
+    /**
+     * Bitmask of the TX channels the remote is subscribed to. Bit 0 of the first byte is channel 1.
+     */
+    uint8_t m_remoteSubscriptions[(tMaxChannels + 7U) / 8U];
+
+    /**
+     * Bitmask of the conflated TX channels.
+     */
+    uint8_t m_conflatedChannels[(tMaxChannels + 7U) / 8U];
+
+    /**
+     * Bitmask of the conflated TX channels with a frame in the TX staging buffer.
+     */
+    uint8_t m_pendingConflatedFrames[(tMaxChannels + 7U) / 8U];
+
+    /**
+     * Position of the queued frame of each conflated TX channel in the byte stream of the TX staging buffer.
+     */
+    uint32_t m_conflatedFramePositions[tMaxChannels];
+
+    /**
+     * Rate limits of the TX channels, owned by the application. nullptr if not limited.
+     */
+    TxRateLimit* m_txRateLimits[tMaxChannels];
+
+    /**
+     * Optional source of frames to be sent in process(). nullptr if none.
+     */
+    TxSource* m_txSource;
+
+    /**
+     * Position of the end of the queued frames of each priority class in the byte stream of the TX staging buffer.
+     * The frames are ordered by priority class, so a class ends where the next lower class starts.
+     */
+    uint32_t m_txClassTails[TX_PRIORITY_CLASSES];
+
+    /**
+     * Timestamp at which each priority class got queued frames.
+     */
+    uint32_t m_txClassPendingSince[TX_PRIORITY_CLASSES];
+
+    /**
+     * Bitmask of the priority classes with queued frames. Bit 0 is TX_PRIORITY_CONTROL.
+     */
+    uint8_t m_pendingTxClasses;
+
+    /**
+     * Position of the end of the frames which are being written, in the byte stream of the TX staging buffer.
+     * No frame is moved ahead of them.
+     */
+    uint32_t m_txLockedEnd;
+
+    /**
+     * Position of the last queued frame in the byte stream of the TX staging buffer.
+     */
+    uint32_t m_lastQueuedFramePosition;
+
+    /**
+     * Statistics of the TX path.
+     */
+    TxStatistics m_txStatistics;
+
+    /**
+     * Number of buffered bytes that triggers a flush.
+     */
+    uint16_t m_txFlushThreshold;
+
+    /**
+     * Maximum time in milliseconds that buffered bytes wait during a batch. 0 if disabled.
+     */
+    uint32_t m_txFlushPeriod;
+
+    /**
+     * Timestamp at which the TX staging buffer became non-empty.
+     */
+    uint32_t m_txPendingSince;
+
+    /**
+     * Timestamp of the current or last call to process().
+     */
+    uint32_t m_currentTimestamp;
 
     /**
      * Number of TX Channels configured.
@@ -790,6 +2715,11 @@ private:
      */
     uint8_t m_numberOfPendingChannels;
 
+    /**
+     * Generation assigned to the last assigned channel slot.
+     */
+    uint8_t m_lastGeneration;
+
     /**
      * User data to be passed to the callbacks.
      */
@@ -806,12 +2736,31 @@ private:
     EventCallback m_onDeSynced;
 
 private:
+    /** TypedChannel uses the send path without DLC check. */
+    template<typename tPayload, const char* tName>
+    friend class TypedChannel;
+
     /* Not allowed. */
     SerialMuxProtServer();                                          /**< Default Constructor */
     SerialMuxProtServer(const SerialMuxProtServer& avg);            /**< Copy Constructor */
     SerialMuxProtServer& operator=(const SerialMuxProtServer& avg); /**< Assignment Operator */
 };
 
+/** Maximum payload length of a frame. */
+template<uint8_t tMaxChannels, uint16_t tRxBufferSize, typename tIntegrity, uint16_t tTxBufferSize,
+         uint8_t tMaxDataLen>
+const uint8_t SerialMuxProtServer<tMaxChannels, tRxBufferSize, tIntegrity, tTxBufferSize, tMaxDataLen>::MAX_PAYLOAD_LEN;
+
+/** Length of the frame header, depending on the integrity policy. */
+template<uint8_t tMaxChannels, uint16_t tRxBufferSize, typename tIntegrity, uint16_t tTxBufferSize,
+         uint8_t tMaxDataLen>
+const uint8_t SerialMuxProtServer<tMaxChannels, tRxBufferSize, tIntegrity, tTxBufferSize, tMaxDataLen>::FRAME_HEADER_LEN;
+
+/** Maximum length of a frame, depending on the integrity policy. */
+template<uint8_t tMaxChannels, uint16_t tRxBufferSize, typename tIntegrity, uint16_t tTxBufferSize,
+         uint8_t tMaxDataLen>
+const uint16_t SerialMuxProtServer<tMaxChannels, tRxBufferSize, tIntegrity, tTxBufferSize, tMaxDataLen>::FRAME_MAX_LEN;
+
 /******************************************************************************
  * Functions
  *****************************************************************************/
@@ -0,0 +1,602 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  TX Buffers of the SerialMuxProt Server.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_TX_BUFFER_H
+#define SERIALMUXPROT_TX_BUFFER_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <Stream.h>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+inline uint16_t copyIoVectors(uint8_t* destination, const IoVector* vectors, uint8_t count, uint16_t offset,
+                              uint16_t length);
+inline void     reverseBytes(uint8_t* first, uint8_t* last);
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Staging buffer and bounded queue for frames to be sent.
+ * Frames are collected and written to the Stream with a single call on flush.
+ * Bytes not accepted by the Stream stay in the buffer and are written first on the next flush,
+ * so frame boundaries are kept on the wire.
+ *
+ * @tparam tSize Size of the staging buffer in bytes. Must be able to hold at least one frame.
+ * @tparam tMaxFrameLen Maximum length of a frame in bytes.
+ */
+template<uint16_t tSize, uint16_t tMaxFrameLen>
+class SerialMuxProtTxBuffer
+{
+public:
+    static_assert(tSize >= tMaxFrameLen, "TX buffer must be able to hold at least one frame.");
+
+    /**
+     * Construct the TX staging buffer.
+     */
+    SerialMuxProtTxBuffer() : m_storage{0U}, m_count(0U), m_writtenBytes(0U)
+    {
+    }
+
+    /**
+     * Destroy the TX staging buffer.
+     */
+    ~SerialMuxProtTxBuffer()
+    {
+    }
+
+    /**
+     * Append a frame to the buffer. Nothing is written to the Stream.
+     * The fragments of the frame are copied directly into the buffer.
+     * @param[in] stream Not used.
+     * @param[in] writer Not used.
+     * @param[in] vectors Fragments of the frame, starting with the header.
+     * @param[in] count Number of fragments.
+     * @param[in] length Length of the frame.
+     * @param[in] maxBytes Not used.
+     * @returns true if the frame has been appended, otherwise false if there is not enough free space.
+     */
+    bool write(Stream& stream, VectoredWriter* writer, const IoVector* vectors, uint8_t count, uint16_t length,
+               uint32_t maxBytes)
+    {
+        bool isWritten = false;
+
+        (void)stream;
+        (void)writer;
+        (void)maxBytes;
+
+        if (getFreeSpace() >= length)
+        {
+            m_count += copyIoVectors(&m_storage[m_count], vectors, count, 0U, length);
+            isWritten = true;
+        }
+
+        return isWritten;
+    }
+
+    /**
+     * Reserve space for a frame at the end of the buffer.
+     * The buffer must not be flushed until the frame is committed.
+     * @param[in] length Length of the frame.
+     * @returns Pointer to the reserved frame, or nullptr if there is not enough free space.
+     */
+    uint8_t* claim(uint16_t length)
+    {
+        return (getFreeSpace() >= length) ? &m_storage[m_count] : nullptr;
+    }
+
+    /**
+     * Append the reserved frame to the buffer. Nothing is written to the Stream.
+     * @param[in] stream Not used.
+     * @param[in] writer Not used.
+     * @param[in] length Length of the frame. Must not be greater than claimed.
+     * @param[in] maxBytes Not used.
+     * @returns Always true.
+     */
+    bool commit(Stream& stream, VectoredWriter* writer, uint16_t length, uint32_t maxBytes)
+    {
+        (void)stream;
+        (void)writer;
+        (void)maxBytes;
+
+        m_count += length;
+
+        return true;
+    }
+
+    /**
+     * Write the buffered bytes to the Stream with a single call.
+     * @param[in] stream Stream to write to.
+     * @param[in] maxBytes Maximum number of bytes to write.
+     * @returns true if the buffer is empty afterwards, otherwise false.
+     */
+    bool flush(Stream& stream, uint32_t maxBytes)
+    {
+        uint16_t toWrite = m_count;
+
+        if (maxBytes < toWrite)
+        {
+            toWrite = static_cast<uint16_t>(maxBytes);
+        }
+
+        if (0U != toWrite)
+        {
+            size_t writtenBytes = stream.write(m_storage, toWrite);
+
+            if (m_count <= writtenBytes)
+            {
+                m_writtenBytes += m_count;
+                m_count         = 0U;
+            }
+            else
+            {
+                /* Keep the remainder for the next flush. */
+                m_writtenBytes += static_cast<uint32_t>(writtenBytes);
+                m_count        -= static_cast<uint16_t>(writtenBytes);
+                memmove(&m_storage[0U], &m_storage[writtenBytes], m_count);
+            }
+        }
+
+        return (0U == m_count);
+    }
+
+    /**
+     * Remove bytes from the end of the buffer, which have not been written yet.
+     * @param[in] length Number of bytes to remove.
+     */
+    void truncate(uint16_t length)
+    {
+        m_count -= (length < m_count) ? length : m_count;
+    }
+
+    /**
+     * Get the position of the end of the buffer in the byte stream.
+     * Positions count all bytes ever appended, so they stay valid when the buffer is flushed.
+     * @returns Position of the next appended byte.
+     */
+    uint32_t getTailPosition() const
+    {
+        return (m_writtenBytes + m_count);
+    }
+
+    /**
+     * Get access to buffered bytes, which have not been written yet.
+     * @param[in] position Position of the first byte in the byte stream.
+     * @param[in] length Number of bytes.
+     * @returns Pointer to the bytes, or nullptr if any of them has already been written.
+     */
+    uint8_t* getUnsent(uint32_t position, uint16_t length)
+    {
+        uint32_t offset = position - m_writtenBytes;
+        uint8_t* unsent = nullptr;
+
+        if ((m_count >= offset) && ((m_count - offset) >= length))
+        {
+            unsent = &m_storage[offset];
+        }
+
+        return unsent;
+    }
+
+    /**
+     * Remove buffered bytes, which have not been written yet. The following bytes are moved up.
+     * @param[in] position Position of the first byte in the byte stream.
+     * @param[in] length Number of bytes.
+     */
+    void erase(uint32_t position, uint16_t length)
+    {
+        uint8_t* unsent = getUnsent(position, length);
+
+        if (nullptr != unsent)
+        {
+            uint16_t offset = static_cast<uint16_t>(unsent - m_storage);
+
+            memmove(unsent, &unsent[length], (m_count - offset - length));
+            m_count -= length;
+        }
+    }
+
+    /**
+     * Move the last bytes of the buffer to an earlier position, which has not been written yet.
+     * The bytes in between move down. The bytes are rotated in place, without temporary storage.
+     * @param[in] position Position in the byte stream to move the bytes to.
+     * @param[in] length Number of bytes at the end of the buffer.
+     */
+    void moveTail(uint32_t position, uint16_t length)
+    {
+        uint8_t* unsent = getUnsent(position, length);
+
+        if (nullptr != unsent)
+        {
+            uint8_t* tail = &m_storage[m_count - length];
+
+            reverseBytes(unsent, tail);
+            reverseBytes(tail, &m_storage[m_count]);
+            reverseBytes(unsent, &m_storage[m_count]);
+        }
+    }
+
+    /**
+     * Get the number of buffered bytes.
+     * @returns Number of bytes waiting to be written.
+     */
+    uint16_t size() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Get the number of bytes that can be appended.
+     * @returns Number of free bytes.
+     */
+    uint16_t getFreeSpace() const
+    {
+        return (tSize - m_count);
+    }
+
+private:
+    /**
+     * Buffer storage.
+     */
+    uint8_t m_storage[tSize];
+
+    /**
+     * Number of buffered bytes.
+     */
+    uint16_t m_count;
+
+    /**
+     * Number of bytes written to the Stream since construction. Wraps around.
+     */
+    uint32_t m_writtenBytes;
+
+private:
+    /* Not allowed. */
+    SerialMuxProtTxBuffer(const SerialMuxProtTxBuffer& buffer);            /**< Copy Constructor */
+    SerialMuxProtTxBuffer& operator=(const SerialMuxProtTxBuffer& buffer); /**< Assignment Operator */
+};
+
+/**
+ * TX path without staging buffer.
+ * Every frame is written directly to the Stream.
+ * If the Stream accepts only a part of a frame, the remainder is kept and written first on the next flush,
+ * so frame boundaries are kept on the wire.
+ *
+ * @tparam tMaxFrameLen Maximum length of a frame in bytes.
+ */
+template<uint16_t tMaxFrameLen>
+class SerialMuxProtTxBuffer<0U, tMaxFrameLen>
+{
+public:
+    /**
+     * Construct the direct TX path.
+     */
+    SerialMuxProtTxBuffer() : m_remainder{0U}, m_remainderIdx(0U), m_remainderCount(0U), m_claimedFrame{0U}
+    {
+    }
+
+    /**
+     * Destroy the direct TX path.
+     */
+    ~SerialMuxProtTxBuffer()
+    {
+    }
+
+    /**
+     * Write a frame directly to the Stream.
+     * With a VectoredWriter, the fragments are written with a single call without copying them.
+     * Otherwise, several fragments are assembled into a contiguous frame first, a single one is written as it is.
+     * A frame is only accepted if no remainder of a previous frame is pending.
+     * @param[in] stream Stream to write to.
+     * @param[in] writer Optional VectoredWriter of the Stream. May be nullptr.
+     * @param[in] vectors Fragments of the frame, starting with the header.
+     * @param[in] count Number of fragments.
+     * @param[in] length Length of the frame.
+     * @param[in] maxBytes Maximum number of bytes to write. The frame is not written if it does not fit.
+     * @returns true if the frame has been written completely or partially, otherwise false.
+     */
+    bool write(Stream& stream, VectoredWriter* writer, const IoVector* vectors, uint8_t count, uint16_t length,
+               uint32_t maxBytes)
+    {
+        bool isWritten = false;
+
+        if ((0U == m_remainderCount) && (maxBytes >= length))
+        {
+            size_t writtenBytes = 0U;
+
+            if (nullptr != writer)
+            {
+                writtenBytes = writer->writev(vectors, count);
+            }
+            else if (1U == count)
+            {
+                /* A single fragment is contiguous already, e.g. a committed staging frame. */
+                writtenBytes = stream.write(static_cast<const uint8_t*>(vectors[0U].m_data), length);
+            }
+            else
+            {
+                uint8_t frame[tMaxFrameLen];
+
+                (void)copyIoVectors(frame, vectors, count, 0U, length);
+                writtenBytes = stream.write(frame, length);
+            }
+
+            if (length > writtenBytes)
+            {
+                /* Keep the remainder for the next flush. */
+                m_remainderIdx   = 0U;
+                m_remainderCount = copyIoVectors(m_remainder, vectors, count, static_cast<uint16_t>(writtenBytes),
+                                                 (length - static_cast<uint16_t>(writtenBytes)));
+            }
+
+            isWritten = true;
+        }
+
+        return isWritten;
+    }
+
+    /**
+     * Reserve the staging frame.
+     * @param[in] length Length of the frame. Must not be greater than tMaxFrameLen.
+     * @returns Pointer to the staging frame.
+     */
+    uint8_t* claim(uint16_t length)
+    {
+        (void)length;
+
+        return m_claimedFrame;
+    }
+
+    /**
+     * Write the staging frame directly to the Stream.
+     * @param[in] stream Stream to write to.
+     * @param[in] writer Optional VectoredWriter of the Stream. May be nullptr.
+     * @param[in] length Length of the frame. Must not be greater than claimed.
+     * @param[in] maxBytes Maximum number of bytes to write. The frame is not written if it does not fit.
+     * @returns true if the frame has been written completely or partially, otherwise false.
+     */
+    bool commit(Stream& stream, VectoredWriter* writer, uint16_t length, uint32_t maxBytes)
+    {
+        IoVector frame(m_claimedFrame, length);
+
+        return write(stream, writer, &frame, 1U, length, maxBytes);
+    }
+
+    /**
+     * Write the remainder of a partially written frame.
+     * @param[in] stream Stream to write to.
+     * @param[in] maxBytes Maximum number of bytes to write.
+     * @returns true if no remainder is pending afterwards, otherwise false.
+     */
+    bool flush(Stream& stream, uint32_t maxBytes)
+    {
+        uint16_t toWrite = m_remainderCount;
+
+        if (maxBytes < toWrite)
+        {
+            toWrite = static_cast<uint16_t>(maxBytes);
+        }
+
+        if (0U != toWrite)
+        {
+            size_t writtenBytes = stream.write(&m_remainder[m_remainderIdx], toWrite);
+
+            if (m_remainderCount <= writtenBytes)
+            {
+                m_remainderCount = 0U;
+            }
+            else
+            {
+                m_remainderIdx += static_cast<uint16_t>(writtenBytes);
+                m_remainderCount -= static_cast<uint16_t>(writtenBytes);
+            }
+        }
+
+        return (0U == m_remainderCount);
+    }
+
+    /**
+     * Remove bytes from the end of the buffer. Nothing to do, as frames are not buffered.
+     * @param[in] length Not used.
+     */
+    void truncate(uint16_t length)
+    {
+        (void)length;
+    }
+
+    /**
+     * Get the position of the end of the buffer in the byte stream.
+     * @returns Always 0, as frames are not buffered.
+     */
+    uint32_t getTailPosition() const
+    {
+        return 0U;
+    }
+
+    /**
+     * Get access to buffered bytes, which have not been written yet.
+     * @param[in] position Not used.
+     * @param[in] length Not used.
+     * @returns Always nullptr, as frames are not buffered.
+     */
+    uint8_t* getUnsent(uint32_t position, uint16_t length)
+    {
+        (void)position;
+        (void)length;
+
+        return nullptr;
+    }
+
+    /**
+     * Remove buffered bytes. Nothing to do, as frames are not buffered.
+     * @param[in] position Not used.
+     * @param[in] length Not used.
+     */
+    void erase(uint32_t position, uint16_t length)
+    {
+        (void)position;
+        (void)length;
+    }
+
+    /**
+     * Move the last buffered bytes to an earlier position. Nothing to do, as frames are not buffered.
+     * @param[in] position Not used.
+     * @param[in] length Not used.
+     */
+    void moveTail(uint32_t position, uint16_t length)
+    {
+        (void)position;
+        (void)length;
+    }
+
+    /**
+     * Get the number of bytes of a partially written frame.
+     * @returns Number of bytes waiting to be written.
+     */
+    uint16_t size() const
+    {
+        return m_remainderCount;
+    }
+
+    /**
+     * Get the number of bytes that can be written.
+     * @returns UINT16_MAX, as frames are not buffered, or 0 if a remainder is pending.
+     */
+    uint16_t getFreeSpace() const
+    {
+        return (0U == m_remainderCount) ? UINT16_MAX : 0U;
+    }
+
+private:
+    /**
+     * Remainder of a partially written frame.
+     */
+    uint8_t m_remainder[tMaxFrameLen];
+
+    /**
+     * Index of the next byte of the remainder to be written.
+     */
+    uint16_t m_remainderIdx;
+
+    /**
+     * Number of bytes of the remainder still to be written.
+     */
+    uint16_t m_remainderCount;
+
+    /**
+     * Staging frame for claim() and commit().
+     */
+    uint8_t m_claimedFrame[tMaxFrameLen];
+
+private:
+    /* Not allowed. */
+    SerialMuxProtTxBuffer(const SerialMuxProtTxBuffer& buffer);            /**< Copy Constructor */
+    SerialMuxProtTxBuffer& operator=(const SerialMuxProtTxBuffer& buffer); /**< Assignment Operator */
+};
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+/**
+ * Copy a range of bytes out of a sequence of fragments.
+ * @param[out] destination Buffer to copy to. Must be able to hold length bytes.
+ * @param[in] vectors Fragments to copy from.
+ * @param[in] count Number of fragments.
+ * @param[in] offset Offset of the first byte to copy, counted over all fragments.
+ * @param[in] length Number of bytes to copy.
+ * @returns Number of bytes copied.
+ */
+inline uint16_t copyIoVectors(uint8_t* destination, const IoVector* vectors, uint8_t count, uint16_t offset,
+                              uint16_t length)
+{
+    uint16_t copiedBytes = 0U;
+
+    for (uint8_t idx = 0U; (idx < count) && (copiedBytes < length); idx++)
+    {
+        uint16_t fragmentLength = vectors[idx].m_length;
+
+        if (offset >= fragmentLength)
+        {
+            /* Fragment is skipped completely. */
+            offset -= fragmentLength;
+        }
+        else
+        {
+            uint16_t chunkSize = fragmentLength - offset;
+
+            if ((length - copiedBytes) < chunkSize)
+            {
+                chunkSize = (length - copiedBytes);
+            }
+
+            memcpy(&destination[copiedBytes], &static_cast<const uint8_t*>(vectors[idx].m_data)[offset], chunkSize);
+            copiedBytes += chunkSize;
+            offset = 0U;
+        }
+    }
+
+    return copiedBytes;
+}
+
+/**
+ * Reverse the order of a range of bytes in place.
+ * @param[in,out] first First byte of the range.
+ * @param[in] last End of the range, behind its last byte.
+ */
+inline void reverseBytes(uint8_t* first, uint8_t* last)
+{
+    while ((first != last) && (first != --last))
+    {
+        uint8_t byte = *first;
+
+        *first = *last;
+        *last  = byte;
+        first++;
+    }
+}
+
+#endif /* SERIALMUXPROT_TX_BUFFER_H */
+/** @} */
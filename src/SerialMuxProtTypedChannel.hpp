@@ -0,0 +1,195 @@
+/* MIT License
+ *
+ * Copyright (c) 2023 - 2024 Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*******************************************************************************
+    DESCRIPTION
+*******************************************************************************/
+/**
+ * @brief  Compile-time typed channels of SerialMuxProt.
+ * @author Gabryel Reyes <gabryelrdiaz@gmail.com>
+ *
+ * @{
+ */
+
+#ifndef SERIALMUXPROT_TYPED_CHANNEL_H
+#define SERIALMUXPROT_TYPED_CHANNEL_H
+
+/******************************************************************************
+ * Includes
+ *****************************************************************************/
+
+#include <SerialMuxProtCommon.hpp>
+#include <string.h>
+
+/******************************************************************************
+ * Macros
+ *****************************************************************************/
+
+/******************************************************************************
+ * Types and Classes
+ *****************************************************************************/
+
+/**
+ * Channel with a payload type known at compile time.
+ * The DLC of the channel is the size of the payload type, so a payload of the wrong size does not compile.
+ *
+ * Example:
+ * @code
+ * extern const char LED_CHANNEL[] = "LED";
+ * TypedChannel<LedData, LED_CHANNEL> gLedChannel;
+ *
+ * gLedChannel.create(gSmpServer);
+ * gLedChannel.publish(gSmpServer, ledData);
+ * @endcode
+ *
+ * @tparam tPayload Payload type. Must be a packed, trivially copyable struct.
+ * @tparam tName Name of the channel. Must be a character array with static storage duration.
+ */
+template<typename tPayload, const char* tName>
+class TypedChannel
+{
+public:
+    static_assert(0U < sizeof(tPayload), "Payload must not be empty.");
+    static_assert(UINT8_MAX >= sizeof(tPayload), "Payload does not fit into a frame.");
+
+    /** DLC of the channel. */
+    static const uint8_t DLC = sizeof(tPayload);
+
+    /**
+     * Typed Channel Notification Prototype Callback.
+     * @param[in] payload Received payload.
+     */
+    typedef void (*Callback)(const tPayload& payload);
+
+    /**
+     * Construct the typed channel.
+     */
+    TypedChannel() : m_handle()
+    {
+    }
+
+    /**
+     * Destroy the typed channel.
+     */
+    ~TypedChannel()
+    {
+    }
+
+    /**
+     * Create the channel as TX channel on the server.
+     * @tparam tServer Type of the SerialMuxProt Server.
+     * @param[in] server Server to create the channel on.
+     * @returns true if the channel has been created, otherwise false.
+     */
+    template<typename tServer>
+    bool create(tServer& server)
+    {
+        static_assert(tServer::MAX_PAYLOAD_LEN >= sizeof(tPayload), "Payload does not fit into a frame.");
+
+        m_handle = server.getTxChannelHandle(server.createChannel(tName, DLC));
+
+        return m_handle.isResolved();
+    }
+
+    /**
+     * Publish a payload on the channel.
+     * No runtime DLC check is necessary, as the payload type defines the DLC.
+     * @tparam tServer Type of the SerialMuxProt Server.
+     * @param[in] server Server the channel has been created on.
+     * @param[in] payload Payload to be sent. It is serialized directly into the frame.
+     * @returns If payload succesfully sent, returns true. Otherwise, false.
+     */
+    template<typename tServer>
+    bool publish(tServer& server, const tPayload& payload) const
+    {
+        return server.sendTypedData(m_handle, &payload, DLC);
+    }
+
+    /**
+     * Subscribe to the channel on the server.
+     * @note The callback is shared by all channels with the same payload type and name.
+     * @tparam tServer Type of the SerialMuxProt Server.
+     * @param[in] server Server to subscribe with.
+     * @param[in] callback Callback to return the incoming payload.
+     */
+    template<typename tServer>
+    static void subscribe(tServer& server, Callback callback)
+    {
+        if (nullptr != callback)
+        {
+            m_callback = callback;
+            server.subscribeToChannel(tName, onReceive);
+        }
+    }
+
+    /**
+     * Get the handle of the TX channel.
+     * @returns Handle of the channel. It is not resolved if the channel has not been created.
+     */
+    const ChannelHandle& getHandle() const
+    {
+        return m_handle;
+    }
+
+private:
+    /**
+     * Receive callback registered on the server.
+     * @param[in] payload Received data.
+     * @param[in] payloadSize Size of the received data.
+     * @param[in] userData User data provided by the application.
+     */
+    static void onReceive(const uint8_t* payload, uint8_t payloadSize, void* userData)
+    {
+        (void)userData;
+
+        if ((nullptr != payload) && (DLC == payloadSize) && (nullptr != m_callback))
+        {
+            tPayload data;
+
+            /* Copy to provide an aligned payload to the application. */
+            memcpy(&data, payload, DLC);
+            m_callback(data);
+        }
+    }
+
+    /**
+     * Callback of the application for the incoming payload.
+     */
+    static Callback m_callback;
+
+    /**
+     * Handle of the TX channel.
+     */
+    ChannelHandle m_handle;
+};
+
+/** Callback of the application for the incoming payload. */
+template<typename tPayload, const char* tName>
+typename TypedChannel<tPayload, tName>::Callback TypedChannel<tPayload, tName>::m_callback = nullptr;
+
+/******************************************************************************
+ * Functions
+ *****************************************************************************/
+
+#endif /* SERIALMUXPROT_TYPED_CHANNEL_H */
+/** @} */
@@ -157,6 +157,15 @@ public:
      */
     virtual size_t write(const uint8_t* buffer, size_t length) = 0;
 
+    /**
+     * Get the number of bytes that can be written without blocking.
+     * @returns Number of bytes. 0 if not supported, as in the Arduino core.
+     */
+    virtual int availableForWrite()
+    {
+        return 0;
+    }
+
 protected:
     /** Construct Print */
     Print()
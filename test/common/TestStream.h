@@ -37,6 +37,7 @@
  *****************************************************************************/
 
 #include <queue>
+#include <stdint.h>
 #include <string.h>
 #include <Stream.h>
 #include <SerialMuxProtCommon.hpp>
@@ -45,6 +46,9 @@
  * Macros
  *****************************************************************************/
 
+/** Size of the output buffer of the Test Stream. Holds several frames of a coalesced write. */
+#define TEST_STREAM_OUTPUT_BUFFER_SIZE (256U)
+
 /******************************************************************************
  * Types and Classes
  *****************************************************************************/
@@ -58,7 +62,8 @@ public:
     /**
      * Stream Constructor.
      */
-    TestStream() : Stream(), m_outputBuffer{0xA5}, m_rcvQueue()
+    TestStream() : Stream(), m_outputBuffer{0xA5}, m_rcvQueue(), m_writeCalls(0U),
+        m_lastWriteBuffer(nullptr), m_writeLimit(SIZE_MAX), m_availableForWrite(TEST_STREAM_OUTPUT_BUFFER_SIZE)
     {
     }
 
@@ -155,13 +160,28 @@ public:
 
     /**
      * Write bytes to stream.
+     * Each write starts at the beginning of the output buffer.
      * @param[in] buffer Byte Array to send.
      * @param[in] length Length of Buffer.
+     * @returns Number of bytes written. Limited by m_writeLimit.
      */
     size_t write(const uint8_t* buffer, size_t length) final
     {
         size_t idx = 0;
 
+        m_writeCalls++;
+        m_lastWriteBuffer = buffer;
+
+        if (m_writeLimit < length)
+        {
+            length = m_writeLimit;
+        }
+
+        if (TEST_STREAM_OUTPUT_BUFFER_SIZE < length)
+        {
+            length = TEST_STREAM_OUTPUT_BUFFER_SIZE;
+        }
+
         for (idx = 0; idx < length; idx++)
         {
             m_outputBuffer[idx] = buffer[idx];
@@ -170,6 +190,15 @@ public:
         return idx;
     }
 
+    /**
+     * Get the number of bytes that can be written without blocking.
+     * @returns Value of m_availableForWrite.
+     */
+    int availableForWrite() final
+    {
+        return m_availableForWrite;
+    }
+
     /**
      * Check if there are available bytes in the Stream.
      * @returns Number of available bytes.
@@ -189,7 +218,7 @@ public:
     {
         size_t count = 0;
 
-        while ((!m_rcvQueue.empty()) && (count <= length))
+        while ((!m_rcvQueue.empty()) && (count < length))
         {
             buffer[count] = m_rcvQueue.front();
             m_rcvQueue.pop();
@@ -212,11 +241,12 @@ public:
     }
 
     /**
-     * Flush output buffer, setting all values to 0x00
+     * Flush output buffer, setting all values to 0xA5, and reset the write counter.
      */
     void flushOutputBuffer()
     {
-        memset(m_outputBuffer, 0xA5, MAX_FRAME_LEN);
+        memset(m_outputBuffer, 0xA5, TEST_STREAM_OUTPUT_BUFFER_SIZE);
+        m_writeCalls = 0U;
     }
 
     /**
@@ -233,12 +263,32 @@ public:
     /**
      * Buffer to write any output of the Stream
      */
-    uint8_t m_outputBuffer[MAX_FRAME_LEN];
+    uint8_t m_outputBuffer[TEST_STREAM_OUTPUT_BUFFER_SIZE];
 
     /**
      * Byte Queue working as an RX Buffer.
      */
     std::queue<uint8_t> m_rcvQueue;
+
+    /**
+     * Number of calls to write() since the last flush of the output buffer.
+     */
+    uint32_t m_writeCalls;
+
+    /**
+     * Buffer passed to the last call to write(). Used to check that frames are written without copy.
+     */
+    const uint8_t* m_lastWriteBuffer;
+
+    /**
+     * Maximum number of bytes accepted by a single call to write(). Used to simulate short writes.
+     */
+    size_t m_writeLimit;
+
+    /**
+     * Number of bytes reported by availableForWrite(). Used to simulate back-pressure.
+     */
+    int m_availableForWrite;
 };
 
 #endif /* TEST_STREAM_H_ */
\ No newline at end of file
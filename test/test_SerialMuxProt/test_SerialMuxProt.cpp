@@ -35,7 +35,22 @@
 #include <unity.h>
 #include <TestStream.h>
 #include <SerialMuxProtServer.hpp>
+#include <SerialMuxProtTypedChannel.hpp>
+#include <SerialMuxProtSegmentation.hpp>
+#include <SerialMuxProtIngestRing.hpp>
+#include <SerialMuxProtPublishQueue.hpp>
 #include <stdio.h>
+#include <atomic>
+#include <thread>
+
+#ifdef TARGET_NATIVE
+#include <SerialMuxProtPosixStream.hpp>
+#include <SerialMuxProtEventLoop.hpp>
+#include <SerialMuxProtRuntime.hpp>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <chrono>
+#endif /* TARGET_NATIVE */
 
 /******************************************************************************
  * Compiler Switches
@@ -49,6 +64,149 @@
  * Types and classes
  *****************************************************************************/
 
+/** Payload of the typed test channel. */
+typedef struct _TypedTestData
+{
+    uint8_t values[4U];                 /**< Test values. */
+} __attribute__((packed)) TypedTestData; /**< Typed test channel payload. */
+
+/**
+ * VectoredWriter recording the fragments of each call into a single output buffer.
+ */
+class TestVectoredWriter : public VectoredWriter
+{
+public:
+    /**
+     * Construct the TestVectoredWriter.
+     */
+    TestVectoredWriter() : VectoredWriter(), m_outputBuffer{0U}, m_writeCalls(0U), m_lastCount(0U)
+    {
+    }
+
+    /**
+     * Write several fragments in order with a single call.
+     * @param[in] vectors Fragments to write.
+     * @param[in] count Number of fragments.
+     * @returns Number of bytes written.
+     */
+    size_t writev(const IoVector* vectors, uint8_t count) final
+    {
+        size_t writtenBytes = 0U;
+
+        m_writeCalls++;
+        m_lastCount = count;
+
+        for (uint8_t idx = 0U; idx < count; idx++)
+        {
+            memcpy(&m_outputBuffer[writtenBytes], vectors[idx].m_data, vectors[idx].m_length);
+            writtenBytes += vectors[idx].m_length;
+        }
+
+        return writtenBytes;
+    }
+
+    uint8_t  m_outputBuffer[TEST_STREAM_OUTPUT_BUFFER_SIZE]; /**< Output of the last call. */
+    uint32_t m_writeCalls;                                   /**< Number of calls to writev(). */
+    uint8_t  m_lastCount;                                    /**< Number of fragments of the last call. */
+};
+
+#ifdef TARGET_NATIVE
+
+/**
+ * Link without server, simulating the processing load of a busy or an idle link.
+ */
+class TestLoadLink : public EventLoopLink
+{
+public:
+    /**
+     * Construct the TestLoadLink.
+     * @param[in] busyTime Time spent per call to process() in microseconds. 0 for an idle link.
+     */
+    explicit TestLoadLink(uint32_t busyTime) : EventLoopLink(), m_peerFds{-1, -1}, m_busyTime(busyTime)
+    {
+        (void)socketpair(AF_UNIX, SOCK_STREAM, 0, m_peerFds);
+    }
+
+    /**
+     * Destroy the TestLoadLink.
+     */
+    ~TestLoadLink()
+    {
+        (void)close(m_peerFds[0U]);
+        (void)close(m_peerFds[1U]);
+    }
+
+    /**
+     * Get the descriptor to wait on. It never becomes readable.
+     * @returns Descriptor.
+     */
+    int getFd() const final
+    {
+        return m_peerFds[0U];
+    }
+
+    /**
+     * Check if the link is still usable.
+     * @returns true, always.
+     */
+    bool isOpen() const final
+    {
+        return true;
+    }
+
+    /**
+     * Spin for the busy time.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @param[in] isReadable Has the descriptor become readable?
+     */
+    void process(uint32_t currentTimestamp, bool isReadable) final
+    {
+        std::chrono::steady_clock::time_point endTime =
+            std::chrono::steady_clock::now() + std::chrono::microseconds(m_busyTime);
+
+        (void)currentTimestamp;
+        (void)isReadable;
+
+        while (std::chrono::steady_clock::now() < endTime)
+        {
+            ;
+        }
+    }
+
+    /**
+     * Ignored, the link never hangs up.
+     */
+    void setHungUp() final
+    {
+    }
+
+    /**
+     * Get the time until the link has to be processed. A busy link is always due.
+     * @param[in] currentTimestamp Time in milliseconds.
+     * @returns Time in milliseconds.
+     */
+    uint32_t getTimeToNextDeadline(uint32_t currentTimestamp) final
+    {
+        (void)currentTimestamp;
+
+        return (0U != m_busyTime) ? 0U : 1000U;
+    }
+
+    /**
+     * Check if bytes are waiting for the descriptor to become writable.
+     * @returns false, always.
+     */
+    bool isTxPending() const final
+    {
+        return false;
+    }
+
+    int      m_peerFds[2U]; /**< Socket pair providing the descriptor. */
+    uint32_t m_busyTime;    /**< Time spent per call to process() in microseconds. */
+};
+
+#endif /* TARGET_NATIVE */
+
 /******************************************************************************
  * Prototypes
  *****************************************************************************/
@@ -63,6 +221,38 @@ static void testCmdScrbRsp();
 static void testChannelCreation();
 static void testDataSend();
 static void testEventCallbacks();
+static void testRxDrain();
+static void testRxResync();
+static void testRxRingBuffer();
+static void testRxZeroCopy();
+static void testChannelHandles();
+static void testTypedChannel();
+static void testTypedChannelCallback(const TypedTestData& payload);
+static void testIntegrityPolicies();
+static void testTxCoalescing();
+static void testTxBackPressure();
+static void testTxPartialWrite();
+static void testTxGather();
+static void testTxClaimCommit();
+static void testMaxPayloadLength();
+static void testSegmentedMessageCallback(const uint8_t* message, uint16_t messageSize, void* userData);
+static void testSegmentedMessages();
+static void testVariableLengthPayload();
+static void testSuperFrames();
+static void testTxSubscriptionFilter();
+static void testTxConflation();
+static void testTxRateLimit();
+static void testTxPriority();
+static void testIngestRing();
+static void testPublishQueue();
+
+#ifdef TARGET_NATIVE
+static size_t readFromPeer(int fd, uint8_t* buffer, size_t length);
+static void testPosixStream();
+static void testEventLoop();
+static void makeSyncResponse(uint8_t* frame);
+static void testRuntime();
+#endif /* TARGET_NATIVE */
 
 /******************************************************************************
  * Local Variables
@@ -73,6 +263,9 @@ static TestStream    gTestStream;
 static const uint8_t controlChannelFrameLength = (HEADER_LEN + CONTROL_CHANNEL_PAYLOAD_LENGTH);
 static const uint8_t testPayload[4U]           = {0x12, 0x34, 0x56, 0x78};
 static bool          callbackCalled            = false;
+static uint8_t       callbackCounter           = 0U;
+static uint8_t       callbackPayloadSize       = 0U;
+static const char    typedChannelName[]        = "TEST";
 
 /******************************************************************************
  * Public Methods
@@ -129,6 +322,34 @@ static void loop()
     RUN_TEST(testChannelCreation);
     RUN_TEST(testDataSend);
     RUN_TEST(testEventCallbacks);
+    RUN_TEST(testRxDrain);
+    RUN_TEST(testRxResync);
+    RUN_TEST(testRxRingBuffer);
+    RUN_TEST(testRxZeroCopy);
+    RUN_TEST(testChannelHandles);
+    RUN_TEST(testTypedChannel);
+    RUN_TEST(testIntegrityPolicies);
+    RUN_TEST(testTxCoalescing);
+    RUN_TEST(testTxBackPressure);
+    RUN_TEST(testTxPartialWrite);
+    RUN_TEST(testTxGather);
+    RUN_TEST(testTxClaimCommit);
+    RUN_TEST(testMaxPayloadLength);
+    RUN_TEST(testSegmentedMessages);
+    RUN_TEST(testVariableLengthPayload);
+    RUN_TEST(testSuperFrames);
+    RUN_TEST(testTxSubscriptionFilter);
+    RUN_TEST(testTxConflation);
+    RUN_TEST(testTxRateLimit);
+    RUN_TEST(testTxPriority);
+    RUN_TEST(testIngestRing);
+    RUN_TEST(testPublishQueue);
+#ifdef TARGET_NATIVE
+    /* The POSIX Stream, the event loop and the runtime are only available on the host. */
+    RUN_TEST(testPosixStream);
+    RUN_TEST(testEventLoop);
+    RUN_TEST(testRuntime);
+#endif /* TARGET_NATIVE */
 
     UNITY_END();
 
@@ -170,7 +391,9 @@ extern void tearDown(void)
  */
 static void testChannelCallback(const uint8_t* payload, uint8_t payloadSize, void* userData)
 {
-    callbackCalled = true;
+    callbackCalled      = true;
+    callbackPayloadSize = payloadSize;
+    callbackCounter++;
     TEST_ASSERT_EQUAL_UINT8_ARRAY(testPayload, payload, payloadSize);
 }
 
@@ -588,4 +811,2282 @@ static void testEventCallbacks()
     testSerialMuxProtServer.process(12000U);
     TEST_ASSERT_FALSE(testSerialMuxProtServer.isSynced());
     TEST_ASSERT_TRUE(callbackCalled);
-}
\ No newline at end of file
+}
+
+/**
+ * Test processing of multiple frames per call on SerialMuxProt Server.
+ */
+static void testRxDrain()
+{
+    SerialMuxProtServer<1U>      testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<1U, 64U> testRingServer(gTestStream);
+    RxDrainResult                result;
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Ignore SYNC */
+    testSerialMuxProtServer.process(0U);
+
+    /* Three SYNC Commands pending. */
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+
+    /*
+     * Case: Frame budget.
+     */
+    result = testSerialMuxProtServer.process(1U, 2U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(2U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength, result.m_pendingBytes);
+
+    /*
+     * Case: Byte budget smaller than a frame. Only the header is read.
+     */
+    result = testSerialMuxProtServer.process(2U, 10U, (controlChannelFrameLength - 1U));
+    TEST_ASSERT_EQUAL_UINT16(0U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength, result.m_pendingBytes);
+
+    /*
+     * Case: Drain remaining frames.
+     */
+    result = testSerialMuxProtServer.process(3U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0U, result.m_pendingBytes);
+
+    /*
+     * Case: Zero budget. A frame read ahead into the RX buffer is not dispatched.
+     */
+    testRingServer.process(0U);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+
+    result = testRingServer.process(4U, 1U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength, result.m_pendingBytes);
+
+    result = testRingServer.process(5U, 0U, 0U);
+    TEST_ASSERT_EQUAL_UINT16(0U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength, result.m_pendingBytes);
+
+    result = testRingServer.process(6U, 10U, 0U);
+    TEST_ASSERT_EQUAL_UINT16(0U, result.m_dispatchedFrames);
+
+    result = testRingServer.process(7U, 0U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(0U, result.m_dispatchedFrames);
+
+    result = testRingServer.process(8U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0U, result.m_pendingBytes);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test frame resynchronization on SerialMuxProt Server.
+ */
+static void testRxResync()
+{
+    SerialMuxProtServer<1U> testSerialMuxProtServer(gTestStream);
+    RxDrainResult           result;
+    const uint8_t           noise[2U]                           = {0x10, 0xFF};
+    uint8_t                 inputQueueVector[2U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00},
+                                                                   {0x00, 0x10, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Ignore SYNC */
+    testSerialMuxProtServer.process(0U);
+
+    /*
+     * Case: Noise before a valid frame.
+     */
+    gTestStream.pushToQueue(noise, sizeof(noise));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    result = testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(1U, testSerialMuxProtServer.getRxStatistics().m_resyncEvents);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(noise), testSerialMuxProtServer.getRxStatistics().m_lastResyncDiscardedBytes);
+
+    /*
+     * Case: Checksum error before a valid frame.
+     */
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    result = testSerialMuxProtServer.process(2U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0U, result.m_pendingBytes);
+    TEST_ASSERT_EQUAL_UINT32(2U, testSerialMuxProtServer.getRxStatistics().m_resyncEvents);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength,
+                             testSerialMuxProtServer.getRxStatistics().m_lastResyncDiscardedBytes);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength,
+                             testSerialMuxProtServer.getRxStatistics().m_maxResyncDiscardedBytes);
+    TEST_ASSERT_EQUAL_UINT32((sizeof(noise) + controlChannelFrameLength),
+                             testSerialMuxProtServer.getRxStatistics().m_discardedBytes);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test RX ring buffer on SerialMuxProt Server.
+ */
+static void testRxRingBuffer()
+{
+    SerialMuxProtServer<1U, 64U> testSerialMuxProtServer(gTestStream);
+    RxDrainResult                result;
+    const uint8_t                noise[1U]                           = {0xFF};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Ignore SYNC */
+    testSerialMuxProtServer.process(0U);
+
+    /* Frames wrap around the end of the ring buffer in the later rounds. */
+    for (uint8_t round = 0U; round < 5U; round++)
+    {
+        gTestStream.pushToQueue(noise, sizeof(noise));
+        gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+        gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+        gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+
+        result = testSerialMuxProtServer.process(round + 1U, 10U, UINT32_MAX);
+        TEST_ASSERT_EQUAL_UINT16(3U, result.m_dispatchedFrames);
+        TEST_ASSERT_EQUAL_UINT32(0U, result.m_pendingBytes);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(5U, testSerialMuxProtServer.getRxStatistics().m_resyncEvents);
+    TEST_ASSERT_EQUAL_UINT32(5U, testSerialMuxProtServer.getRxStatistics().m_discardedBytes);
+
+    /*
+     * Case: Frame budget leaves frames in the ring buffer.
+     */
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    result = testSerialMuxProtServer.process(10U, 1U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength, result.m_pendingBytes);
+    TEST_ASSERT_EQUAL_INT(0, gTestStream.available());
+
+    result = testSerialMuxProtServer.process(11U, 1U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(1U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0U, result.m_pendingBytes);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test in-place delivery of received frames from the RX ring buffer.
+ */
+static void testRxZeroCopy()
+{
+    SerialMuxProtServer<1U, 40U> testSerialMuxProtServer(gTestStream);
+    RxDrainResult                result;
+    uint8_t                      inputQueueVector[3U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'},
+        {0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    const uint8_t dataFrameLength = HEADER_LEN + sizeof(testPayload);
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Sync and subscribe. */
+    testSerialMuxProtServer.subscribeToChannel("TEST", testChannelCallback);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    result = testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(2U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.getNumberOfRxChannels());
+
+    /* Contiguous and wrapped frames provide the same payload. */
+    callbackCounter = 0U;
+
+    for (uint8_t round = 0U; round < 4U; round++)
+    {
+        gTestStream.pushToQueue(inputQueueVector[2U], dataFrameLength);
+        gTestStream.pushToQueue(inputQueueVector[2U], dataFrameLength);
+        gTestStream.pushToQueue(inputQueueVector[2U], dataFrameLength);
+
+        result = testSerialMuxProtServer.process(round + 2U, 10U, UINT32_MAX);
+        TEST_ASSERT_EQUAL_UINT16(3U, result.m_dispatchedFrames);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(12U, callbackCounter);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test channel handles on SerialMuxProt Server.
+ */
+static void testChannelHandles()
+{
+    SerialMuxProtServer<2U> testSerialMuxProtServer(gTestStream);
+    ChannelHandle           txHandle;
+    ChannelHandle           rxHandle;
+    ChannelHandle           staleHandle;
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t                 inputQueueVector[2U][MAX_FRAME_LEN]           = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Unresolved handles.
+     */
+    TEST_ASSERT_FALSE(txHandle.isResolved());
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isTxChannelHandleValid(txHandle));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.getTxChannelHandle("TEST").isResolved());
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.getRxChannelHandle("TEST").isResolved());
+
+    /*
+     * Case: TX handle.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    txHandle = testSerialMuxProtServer.getTxChannelHandle("TEST");
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isTxChannelHandleValid(txHandle));
+    TEST_ASSERT_EQUAL_UINT8(1U, txHandle.m_channelNumber);
+
+    /* Not synced. */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(txHandle, testPayload, sizeof(testPayload)));
+
+    /* Sync and subscribe. */
+    testSerialMuxProtServer.subscribeToChannel("TEST", testChannelCallback);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(txHandle, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, sizeof(testPayload));
+
+    /* Stale handle. */
+    staleHandle = txHandle;
+    staleHandle.m_generation++;
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isTxChannelHandleValid(staleHandle));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(staleHandle, testPayload, sizeof(testPayload)));
+
+    /*
+     * Case: RX handle.
+     */
+    rxHandle = testSerialMuxProtServer.getRxChannelHandle("TEST");
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isRxChannelHandleValid(rxHandle));
+    TEST_ASSERT_EQUAL_UINT8(1U, rxHandle.m_channelNumber);
+
+    /* Subscription is confirmed again. Old handle is stale. */
+    testSerialMuxProtServer.subscribeToChannel("TEST", testChannelCallback);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(2U, 10U, UINT32_MAX);
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isRxChannelHandleValid(rxHandle));
+    TEST_ASSERT_TRUE(
+        testSerialMuxProtServer.isRxChannelHandleValid(testSerialMuxProtServer.getRxChannelHandle("TEST")));
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Callback for incoming data from typed test channel.
+ * @param[in] payload Received payload.
+ */
+static void testTypedChannelCallback(const TypedTestData& payload)
+{
+    callbackCounter++;
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(testPayload, payload.values, sizeof(testPayload));
+}
+
+/**
+ * Test typed channels on SerialMuxProt Server.
+ */
+static void testTypedChannel()
+{
+    SerialMuxProtServer<2U>                       testSerialMuxProtServer(gTestStream);
+    TypedChannel<TypedTestData, typedChannelName> testChannel;
+    TypedTestData                                 payload;
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[2U][MAX_FRAME_LEN]           = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'}};
+
+    memcpy(payload.values, testPayload, sizeof(testPayload));
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Not created. */
+    TEST_ASSERT_FALSE(testChannel.publish(testSerialMuxProtServer, payload));
+
+    TEST_ASSERT_TRUE(testChannel.create(testSerialMuxProtServer));
+    TEST_ASSERT_EQUAL_UINT8(1U, testChannel.getHandle().m_channelNumber);
+
+    /* Not synced. */
+    TEST_ASSERT_FALSE(testChannel.publish(testSerialMuxProtServer, payload));
+
+    /* Sync and subscribe. */
+    TypedChannel<TypedTestData, typedChannelName>::subscribe(testSerialMuxProtServer, testTypedChannelCallback);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.getNumberOfRxChannels());
+    gTestStream.flushOutputBuffer();
+
+    /* Publish. */
+    TEST_ASSERT_TRUE(testChannel.publish(testSerialMuxProtServer, payload));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer,
+                                  (HEADER_LEN + sizeof(TypedTestData)));
+
+    /* Receive. */
+    callbackCounter = 0U;
+    gTestStream.pushToQueue(expectedOutputBufferVector[0U], (HEADER_LEN + sizeof(TypedTestData)));
+    (void)testSerialMuxProtServer.process(2U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8(1U, callbackCounter);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test the frame integrity policies.
+ */
+static void testIntegrityPolicies()
+{
+    SerialMuxProtServer<1U, 0U, Crc16Checksum> testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<1U>                    sumSerialMuxProtServer(gTestStream);
+    const uint8_t                              checkInput[9U] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    const uint8_t crc16FrameLength = (Crc16Checksum::LENGTH + CHANNEL_LEN + DLC_LEN + CONTROL_CHANNEL_PAYLOAD_LENGTH);
+    uint8_t       checksumField[2U] = {0U};
+    uint8_t       syncFrame[crc16FrameLength];
+
+    /*
+     * Case: Check values of the CRC algorithms.
+     */
+    Crc8Checksum::finish(Crc8Checksum::update(Crc8Checksum::begin(), checkInput, sizeof(checkInput)), checksumField);
+    TEST_ASSERT_EQUAL_UINT8(0xF4, checksumField[0U]);
+
+    Crc16Checksum::finish(Crc16Checksum::update(Crc16Checksum::begin(), checkInput, sizeof(checkInput)),
+                          checksumField);
+    TEST_ASSERT_EQUAL_UINT8(0x29, checksumField[0U]);
+    TEST_ASSERT_EQUAL_UINT8(0xB1, checksumField[1U]);
+
+    /* Incremental update gives the same result. */
+    Crc16Checksum::finish(Crc16Checksum::update(Crc16Checksum::update(Crc16Checksum::begin(), checkInput, 2U),
+                                                &checkInput[2U], (sizeof(checkInput) - 2U)),
+                          checksumField);
+    TEST_ASSERT_EQUAL_UINT8(0x29, checksumField[0U]);
+    TEST_ASSERT_EQUAL_UINT8(0xB1, checksumField[1U]);
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Server with CRC-16 sends a SYNC with a 4 byte header.
+     */
+    testSerialMuxProtServer.process(1000U);
+    TEST_ASSERT_EQUAL_UINT8(4U, (SerialMuxProtServer<1U, 0U, Crc16Checksum>::FRAME_HEADER_LEN));
+    TEST_ASSERT_EQUAL_UINT8(CONTROL_CHANNEL_NUMBER, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(CONTROL_CHANNEL_PAYLOAD_LENGTH, gTestStream.m_outputBuffer[DLC_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(SYNC, gTestStream.m_outputBuffer[4U]);
+    memcpy(syncFrame, gTestStream.m_outputBuffer, crc16FrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Server with CRC-16 answers its own SYNC.
+     */
+    gTestStream.pushToQueue(syncFrame, crc16FrameLength);
+    testSerialMuxProtServer.process(1001U);
+    TEST_ASSERT_EQUAL_UINT8(SYNC_RSP, gTestStream.m_outputBuffer[4U]);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Corrupted CRC-16 frame is discarded.
+     */
+    syncFrame[crc16FrameLength - 1U] ^= 0x01;
+    gTestStream.pushToQueue(syncFrame, crc16FrameLength);
+    (void)testSerialMuxProtServer.process(1002U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(emptyOutputBuffer, gTestStream.m_outputBuffer, crc16FrameLength);
+    TEST_ASSERT_NOT_EQUAL(0U, testSerialMuxProtServer.getRxStatistics().m_resyncEvents);
+    syncFrame[crc16FrameLength - 1U] ^= 0x01;
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Server with the default checksum does not accept a CRC-16 frame.
+     */
+    gTestStream.pushToQueue(syncFrame, crc16FrameLength);
+    (void)sumSerialMuxProtServer.process(2U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(emptyOutputBuffer, gTestStream.m_outputBuffer, controlChannelFrameLength);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test TX write coalescing of SerialMuxProt Server.
+ */
+static void testTxCoalescing()
+{
+    SerialMuxProtServer<2U, 0U, SumChecksum, 128U> testSerialMuxProtServer(gTestStream);
+    const uint8_t                                  dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN]          = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[2U][MAX_FRAME_LEN]                    = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+                                                                      {0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Frames sent outside of process() and batches are written right away.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Frames of a batch are written with a single call.
+     */
+    testSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16((3U * dataFrameLength), testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+
+    for (uint8_t idx = 0U; idx < 3U; idx++)
+    {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U],
+                                      &gTestStream.m_outputBuffer[idx * dataFrameLength], dataFrameLength);
+    }
+
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Frames sent during process() are written with a single call.
+     */
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(inputQueueVector[0U], gTestStream.m_outputBuffer, controlChannelFrameLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(inputQueueVector[0U], &gTestStream.m_outputBuffer[controlChannelFrameLength],
+                                  controlChannelFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Size threshold.
+     */
+    testSerialMuxProtServer.setTxFlushThresholds((2U * dataFrameLength), 0U);
+    testSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.flush());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Time threshold.
+     */
+    testSerialMuxProtServer.setTxFlushThresholds(128U, 100U);
+    (void)testSerialMuxProtServer.process(10U, 10U, UINT32_MAX);
+    testSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    (void)testSerialMuxProtServer.process(50U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+    (void)testSerialMuxProtServer.process(110U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.flush());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Short write keeps the remainder.
+     */
+    testSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    gTestStream.m_writeLimit = 10U;
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT16(((2U * dataFrameLength) - 10U), testSerialMuxProtServer.getPendingTxBytes());
+    gTestStream.m_writeLimit = SIZE_MAX;
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.flush());
+
+    /* Remainder of the second frame. */
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&expectedOutputBufferVector[0U][10U - dataFrameLength], gTestStream.m_outputBuffer,
+                                  ((2U * dataFrameLength) - 10U));
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test non-blocking TX queue of SerialMuxProt Server.
+ */
+static void testTxBackPressure()
+{
+    SerialMuxProtServer<2U, 0U, SumChecksum, 40U> testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<2U>                       directSerialMuxProtServer(gTestStream);
+    const uint8_t                                 dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    SendStatus                                    status          = SEND_SENT;
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Not synced.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_REJECTED, status);
+
+    /* Sync. */
+    testSerialMuxProtServer.enableTxBackPressure(true);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Stream accepts nothing. Frames are queued until the queue is full.
+     */
+    gTestStream.m_availableForWrite = 0;
+
+    for (uint8_t idx = 0U; idx < 5U; idx++)
+    {
+        TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+        TEST_ASSERT_EQUAL_UINT8(SEND_QUEUED, status);
+    }
+
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_QUEUE_FULL, status);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16((5U * dataFrameLength), testSerialMuxProtServer.getPendingTxBytes());
+
+    /*
+     * Case: Stream accepts a part of the queue. The rest is written on the next process().
+     */
+    gTestStream.m_availableForWrite = 10;
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16(((5U * dataFrameLength) - 10U), testSerialMuxProtServer.getPendingTxBytes());
+
+    gTestStream.m_availableForWrite = TEST_STREAM_OUTPUT_BUFFER_SIZE;
+    (void)testSerialMuxProtServer.process(2U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(2U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+
+    /*
+     * Case: Stream accepts the frame right away.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Without TX queue, a frame is only written if it fits completely.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, directSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    directSerialMuxProtServer.enableTxBackPressure(true);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)directSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(directSerialMuxProtServer.isSynced());
+
+    gTestStream.m_availableForWrite = (dataFrameLength - 1U);
+    TEST_ASSERT_FALSE(directSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_QUEUE_FULL, status);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+
+    gTestStream.m_availableForWrite = dataFrameLength;
+    TEST_ASSERT_TRUE(directSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+
+    gTestStream.m_availableForWrite = TEST_STREAM_OUTPUT_BUFFER_SIZE;
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test resuming partially written frames of SerialMuxProt Server.
+ */
+static void testTxPartialWrite()
+{
+    SerialMuxProtServer<2U> testSerialMuxProtServer(gTestStream);
+    const uint8_t           dataFrameLength                               = (HEADER_LEN + sizeof(testPayload));
+    SendStatus              status                                        = SEND_SENT;
+    uint8_t                 expectedOutputBufferVector[2U][MAX_FRAME_LEN] = {
+        {0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'}};
+    uint8_t inputQueueVector[2U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x53, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 'T', 'E', 'S', 'T'}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Short write of a data frame. The remainder is written on the next process().
+     */
+    gTestStream.m_writeLimit = 3U;
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_QUEUED, status);
+    TEST_ASSERT_EQUAL_UINT16((dataFrameLength - 6U), testSerialMuxProtServer.getPendingTxBytes());
+
+    /* No new frame while the remainder is pending. */
+    gTestStream.m_writeLimit = 0U;
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_QUEUE_FULL, status);
+
+    gTestStream.m_writeLimit = SIZE_MAX;
+    gTestStream.flushOutputBuffer();
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&expectedOutputBufferVector[0U][6U], gTestStream.m_outputBuffer,
+                                  (dataFrameLength - 6U));
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Short write of a SCRB_RSP does not fall out of sync.
+     */
+    gTestStream.m_writeLimit = 5U;
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(2U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    TEST_ASSERT_NOT_EQUAL(0U, testSerialMuxProtServer.getPendingTxBytes());
+
+    gTestStream.m_writeLimit = SIZE_MAX;
+    gTestStream.flushOutputBuffer();
+    (void)testSerialMuxProtServer.process(3U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&expectedOutputBufferVector[1U][15U], gTestStream.m_outputBuffer,
+                                  (controlChannelFrameLength - 15U));
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test gather send of SerialMuxProt Server.
+ */
+static void testTxGather()
+{
+    SerialMuxProtServer<2U>                       testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<2U, 0U, SumChecksum, 64U> bufferedSerialMuxProtServer(gTestStream);
+    TestVectoredWriter                            writer;
+    const uint8_t                                 dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    SendStatus                                    status          = SEND_SENT;
+    IoVector                                      fragments[2U]   = {IoVector(&testPayload[0U], 1U),
+                                                                     IoVector(&testPayload[1U], 3U)};
+    IoVector                                      tooLong[2U]     = {IoVector(&testPayload[0U], 4U),
+                                                                     IoVector(&testPayload[0U], 1U)};
+    uint8_t  expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t  inputQueueVector[1U][MAX_FRAME_LEN]           = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Fragments must not exceed the DLC of the channel.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendDataGather(1U, tooLong, 2U, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_REJECTED, status);
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendDataGather(1U, fragments, (MAX_TX_FRAGMENTS + 1U)));
+
+    /*
+     * Case: Without VectoredWriter, the frame is written with a single call to the Stream.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendDataGather(1U, fragments, 2U, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: With VectoredWriter, header and fragments are written with a single vectored call.
+     */
+    testSerialMuxProtServer.setVectoredWriter(&writer);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendDataGather(1U, fragments, 2U, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT32(1U, writer.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8(3U, writer.m_lastCount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], writer.m_outputBuffer, dataFrameLength);
+
+    /* Also used by the contiguous send. */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(2U, writer.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8(2U, writer.m_lastCount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], writer.m_outputBuffer, dataFrameLength);
+    testSerialMuxProtServer.setVectoredWriter(nullptr);
+
+    /*
+     * Case: Fragments are copied directly into the TX staging buffer.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, bufferedSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)bufferedSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendDataGather(1U, fragments, 2U, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_QUEUED, status);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test in-place claim and commit of SerialMuxProt Server.
+ */
+static void testTxClaimCommit()
+{
+    SerialMuxProtServer<2U>                       testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<2U, 0U, SumChecksum, 64U> bufferedSerialMuxProtServer(gTestStream);
+    const uint8_t                                 dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    SendStatus                                    status          = SEND_SENT;
+    uint8_t*                                      payload         = nullptr;
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN]         = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN]                   = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Not synced.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_NULL(testSerialMuxProtServer.claim(1U));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.commit(status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_REJECTED, status);
+
+    /* Sync. */
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Unknown channel and control channel.
+     */
+    TEST_ASSERT_NULL(testSerialMuxProtServer.claim(2U));
+    TEST_ASSERT_NULL(testSerialMuxProtServer.claim(CONTROL_CHANNEL_NUMBER));
+
+    /*
+     * Case: Without TX staging buffer, the frame is built in a staging frame.
+     */
+    payload = testSerialMuxProtServer.claim(1U);
+    TEST_ASSERT_NOT_NULL(payload);
+    TEST_ASSERT_NULL(testSerialMuxProtServer.claim(1U));
+    memcpy(payload, testPayload, sizeof(testPayload));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.commit(status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+
+    /* The staging frame is written as it is, without copy. */
+    TEST_ASSERT_TRUE((payload - HEADER_LEN) == gTestStream.m_lastWriteBuffer);
+    gTestStream.flushOutputBuffer();
+
+    /* Aborted frame is not sent. */
+    TEST_ASSERT_NOT_NULL(testSerialMuxProtServer.claim(1U));
+    testSerialMuxProtServer.abort();
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.commit());
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+
+    /* The remainder of a partially written frame is written while a frame is claimed. */
+    gTestStream.m_writeLimit = 3U;
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    gTestStream.m_writeLimit = 0U;
+    payload                  = testSerialMuxProtServer.claim(1U);
+    TEST_ASSERT_NOT_NULL(payload);
+    TEST_ASSERT_NOT_EQUAL(0U, testSerialMuxProtServer.getPendingTxBytes());
+    memcpy(payload, testPayload, sizeof(testPayload));
+    gTestStream.m_writeLimit = SIZE_MAX;
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT16(0U, testSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.commit(status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: With TX staging buffer, the frame is built in the buffer and not flushed until committed.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, bufferedSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)bufferedSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    gTestStream.flushOutputBuffer();
+
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    payload = bufferedSerialMuxProtServer.claim(1U);
+    TEST_ASSERT_NOT_NULL(payload);
+    memcpy(payload, testPayload, sizeof(testPayload));
+
+    /* Other frames are rejected and nothing is flushed. */
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_QUEUE_FULL, status);
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.commit(status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], &gTestStream.m_outputBuffer[dataFrameLength],
+                                  dataFrameLength);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test configurable maximum payload length of SerialMuxProt Server.
+ */
+static void testMaxPayloadLength()
+{
+    SerialMuxProtServer<2U, 0U, SumChecksum, 0U, 64U> testSerialMuxProtServer(gTestStream);
+    const uint16_t                                    largeFrameLength = (HEADER_LEN + 64U);
+    uint8_t                                           largePayload[64U];
+    uint8_t                                           largeFrame[HEADER_LEN + 64U];
+    uint8_t expectedOutputBufferVector[2U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x3C, 0x00, 0xE8, 0x03, 0x00, 0x00, 0x40}, /* SYNC 1000ms, limit 64 */
+        {0x00, 0x10, 0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x40}  /* SYNC_RSP 0ms, limit 64 */
+    };
+    uint8_t inputQueueVector[4U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},       /* SYNC_RSP 0ms, default limit */
+        {0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00},       /* SYNC 0ms, default limit */
+        {0x00, 0x10, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40}, /* SYNC 0ms, limit 64 */
+        {0x00, 0x10, 0x51, 0x01, 0x00, 0x00, 0x00, 0x00, 0x40}  /* SYNC_RSP 0ms, limit 64 */
+    };
+
+    memset(largePayload, 0x5A, sizeof(largePayload));
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    TEST_ASSERT_EQUAL_UINT8(64U, (SerialMuxProtServer<2U, 0U, SumChecksum, 0U, 64U>::MAX_PAYLOAD_LEN));
+
+    /*
+     * Case: Channels up to the maximum payload length.
+     */
+    TEST_ASSERT_EQUAL_UINT8(0U, testSerialMuxProtServer.createChannel("LARGE", 65U));
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("LARGE", 64U));
+
+    /*
+     * Case: SYNC advertises the limit.
+     */
+    testSerialMuxProtServer.process(1000U);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer,
+                                  controlChannelFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Client with the default limit. SYNC is not answered and SYNC_RSP does not sync.
+     */
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(1001U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(emptyOutputBuffer, gTestStream.m_outputBuffer, controlChannelFrameLength);
+    TEST_ASSERT_EQUAL_UINT8(MAX_DATA_LEN, testSerialMuxProtServer.getRemoteMaxDataLength());
+
+    testSerialMuxProtServer.process(2000U);
+    gTestStream.flushOutputBuffer();
+    inputQueueVector[0U][2U] = 0xE8; /* Checksum of SYNC_RSP 2000ms. */
+    inputQueueVector[0U][4U] = 0xD0;
+    inputQueueVector[0U][5U] = 0x07;
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(2001U, 10U, UINT32_MAX);
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isSynced());
+
+    /*
+     * Case: Client with the same limit.
+     */
+    gTestStream.pushToQueue(inputQueueVector[2U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(2002U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], gTestStream.m_outputBuffer,
+                                  controlChannelFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    testSerialMuxProtServer.process(3000U);
+    gTestStream.flushOutputBuffer();
+    inputQueueVector[3U][2U] = 0x15; /* Checksum of SYNC_RSP 3000ms, limit 64. */
+    inputQueueVector[3U][4U] = 0xB8;
+    inputQueueVector[3U][5U] = 0x0B;
+    gTestStream.pushToQueue(inputQueueVector[3U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(3001U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    TEST_ASSERT_EQUAL_UINT8(64U, testSerialMuxProtServer.getRemoteMaxDataLength());
+
+    /*
+     * Case: Large frames are sent and accepted by the receiver.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, largePayload, sizeof(largePayload)));
+    TEST_ASSERT_EQUAL_UINT8(1U, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(64U, gTestStream.m_outputBuffer[DLC_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(largePayload, &gTestStream.m_outputBuffer[HEADER_LEN], sizeof(largePayload));
+    memcpy(largeFrame, gTestStream.m_outputBuffer, largeFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    gTestStream.pushToQueue(largeFrame, largeFrameLength);
+    (void)testSerialMuxProtServer.process(3002U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(0U, testSerialMuxProtServer.getRxStatistics().m_resyncEvents);
+    TEST_ASSERT_EQUAL_INT(0, gTestStream.available());
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Callback for the segmented message test.
+ * @param[in] message Reassembled message.
+ * @param[in] messageSize Size of the message.
+ * @param[in] userData User data provided by the receiver.
+ */
+static void testSegmentedMessageCallback(const uint8_t* message, uint16_t messageSize, void* userData)
+{
+    const uint8_t* expectedMessage = static_cast<const uint8_t*>(userData);
+
+    callbackCounter++;
+    TEST_ASSERT_EQUAL_UINT16(30U, messageSize);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedMessage, message, messageSize);
+}
+
+/**
+ * Test segmented messages on SerialMuxProt Server.
+ */
+static void testSegmentedMessages()
+{
+    SerialMuxProtServer<2U> testSerialMuxProtServer(gTestStream);
+    SegmentSender           sender;
+    uint8_t                 message[30U];
+    uint8_t                 receiveBuffer[32U];
+    uint8_t                 smallBuffer[16U];
+    SegmentReceiver         receiver(receiveBuffer, sizeof(receiveBuffer), testSegmentedMessageCallback, message);
+    SegmentReceiver         smallReceiver(smallBuffer, sizeof(smallBuffer), testSegmentedMessageCallback, message);
+    const uint8_t           segmentDLC                          = 16U;
+    uint8_t                 inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    for (uint8_t idx = 0U; idx < sizeof(message); idx++)
+    {
+        message[idx] = idx;
+    }
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+    callbackCounter = 0U;
+
+    /*
+     * Case: Invalid channel and message.
+     */
+    TEST_ASSERT_FALSE(sender.send(message, sizeof(message)));
+    TEST_ASSERT_FALSE(sender.create(testSerialMuxProtServer, "SEG", SEGMENT_HEADER_LEN));
+    TEST_ASSERT_TRUE(sender.create(testSerialMuxProtServer, "SEG", segmentDLC));
+    TEST_ASSERT_EQUAL_UINT8(1U, sender.getChannelNumber());
+    TEST_ASSERT_EQUAL_UINT8(2U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_FALSE(sender.send(nullptr, sizeof(message)));
+    TEST_ASSERT_FALSE(sender.send(message, 0U));
+
+    /*
+     * Case: Not synced. The fragment is sent after sync.
+     */
+    TEST_ASSERT_TRUE(sender.send(message, sizeof(message)));
+    TEST_ASSERT_TRUE(sender.isBusy());
+    TEST_ASSERT_FALSE(sender.send(message, sizeof(message)));
+    TEST_ASSERT_FALSE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(emptyOutputBuffer, gTestStream.m_outputBuffer, MAX_FRAME_LEN);
+
+    /* Sync. */
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: One fragment per call, interleaved with another channel. The callback is called once.
+     */
+    TEST_ASSERT_TRUE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_EQUAL_UINT8(1U, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(segmentDLC, gTestStream.m_outputBuffer[DLC_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(0U, gTestStream.m_outputBuffer[HEADER_LEN + SEGMENT_FRAGMENT_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(message), gTestStream.m_outputBuffer[HEADER_LEN + SEGMENT_LENGTH_IDX]);
+    TEST_ASSERT_FALSE(receiver.receive(&gTestStream.m_outputBuffer[HEADER_LEN], segmentDLC));
+
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(2U, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+
+    TEST_ASSERT_TRUE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_EQUAL_UINT8(1U, gTestStream.m_outputBuffer[HEADER_LEN + SEGMENT_FRAGMENT_IDX]);
+    TEST_ASSERT_FALSE(receiver.receive(&gTestStream.m_outputBuffer[HEADER_LEN], segmentDLC));
+    TEST_ASSERT_TRUE(sender.isBusy());
+
+    TEST_ASSERT_TRUE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_EQUAL_UINT8(2U, gTestStream.m_outputBuffer[HEADER_LEN + SEGMENT_FRAGMENT_IDX]);
+    TEST_ASSERT_EQUAL_UINT8((SEGMENT_HEADER_LEN + 8U), gTestStream.m_outputBuffer[DLC_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(0U, callbackCounter);
+    TEST_ASSERT_TRUE(receiver.receive(&gTestStream.m_outputBuffer[HEADER_LEN], (SEGMENT_HEADER_LEN + 8U)));
+    TEST_ASSERT_EQUAL_UINT8(1U, callbackCounter);
+    TEST_ASSERT_FALSE(sender.isBusy());
+    TEST_ASSERT_FALSE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_EQUAL_UINT32(0U, receiver.getDroppedMessages());
+
+    /*
+     * Case: Missing fragment. The message is dropped.
+     */
+    TEST_ASSERT_TRUE(sender.send(message, sizeof(message)));
+    TEST_ASSERT_TRUE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_FALSE(receiver.receive(&gTestStream.m_outputBuffer[HEADER_LEN], segmentDLC));
+    TEST_ASSERT_FALSE(smallReceiver.receive(&gTestStream.m_outputBuffer[HEADER_LEN], segmentDLC));
+    TEST_ASSERT_TRUE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_TRUE(sender.process(testSerialMuxProtServer));
+    TEST_ASSERT_FALSE(receiver.receive(&gTestStream.m_outputBuffer[HEADER_LEN], (SEGMENT_HEADER_LEN + 8U)));
+    TEST_ASSERT_EQUAL_UINT32(1U, receiver.getDroppedMessages());
+    TEST_ASSERT_EQUAL_UINT8(1U, callbackCounter);
+
+    /*
+     * Case: Message does not fit into the buffer.
+     */
+    TEST_ASSERT_EQUAL_UINT32(1U, smallReceiver.getDroppedMessages());
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test payloads shorter than the DLC of the channel on SerialMuxProt Server.
+ */
+static void testVariableLengthPayload()
+{
+    SerialMuxProtServer<1U> testSerialMuxProtServer(gTestStream);
+    const uint8_t           shortPayloadSize = 2U;
+    const uint8_t           shortFrameLength = (HEADER_LEN + shortPayloadSize);
+    SendStatus              status           = SEND_SENT;
+    uint8_t*                payload          = nullptr;
+    IoVector                fragments[2U]    = {IoVector(&testPayload[0U], 1U), IoVector(&testPayload[1U], 1U)};
+    uint8_t                 tooLong[5U]      = {0x12, 0x34, 0x56, 0x78, 0x9A};
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x02, 0x49, 0x12, 0x34}};
+    uint8_t inputQueueVector[3U][MAX_FRAME_LEN]           = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'},
+        {0x01, 0x02, 0x49, 0x12, 0x34}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Sync and subscribe. */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    testSerialMuxProtServer.subscribeToChannel("TEST", testChannelCallback);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Empty payload and payload longer than the DLC.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, 0U, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_REJECTED, status);
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, tooLong, sizeof(tooLong), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_REJECTED, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(emptyOutputBuffer, gTestStream.m_outputBuffer, MAX_FRAME_LEN);
+
+    /*
+     * Case: Shorter payload. Only its bytes are sent.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, shortPayloadSize, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, shortFrameLength);
+    TEST_ASSERT_EQUAL_UINT8(0xA5, gTestStream.m_outputBuffer[shortFrameLength]);
+    gTestStream.flushOutputBuffer();
+
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendDataGather(1U, fragments, 2U));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, shortFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Claimed frame committed with a shorter payload. An invalid size keeps the frame claimed.
+     */
+    payload = testSerialMuxProtServer.claim(1U);
+    TEST_ASSERT_NOT_NULL(payload);
+    memcpy(payload, testPayload, sizeof(testPayload));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.commit(static_cast<uint8_t>(sizeof(tooLong)), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_REJECTED, status);
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.commit(0U, status));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.commit(shortPayloadSize, status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, shortFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: The callback receives the actual payload size.
+     */
+    callbackCounter     = 0U;
+    callbackPayloadSize = 0U;
+    gTestStream.pushToQueue(inputQueueVector[2U], shortFrameLength);
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8(1U, callbackCounter);
+    TEST_ASSERT_EQUAL_UINT8(shortPayloadSize, callbackPayloadSize);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test super-frames on SerialMuxProt Server.
+ */
+static void testSuperFrames()
+{
+    SerialMuxProtServer<2U>                       testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<2U, 0U, SumChecksum, 64U> bufferedSerialMuxProtServer(gTestStream);
+    const uint8_t                                 superFrameLength = (HEADER_LEN + 10U);
+    const uint8_t                                 dataFrameLength  = (HEADER_LEN + sizeof(testPayload));
+    uint8_t expectedOutputBufferVector[2U][MAX_FRAME_LEN]          = {
+        {0xFF, 0x0A, 0x6E, 0x01, 0x04, 0x12, 0x34, 0x56, 0x78, 0x02, 0x02, 0x12, 0x34},
+        {0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[3U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'},
+        {0xFF, 0x12, 0x91, 0x01, 0x04, 0x12, 0x34, 0x56, 0x78, 0x02, 0x04, 0x12,
+         0x34, 0x56, 0x78, 0x01, 0x02, 0x12, 0x34, 0x01, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Super-frames require the TX staging buffer.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.enableSuperFrames(true));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.enableSuperFrames(false));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.enableSuperFrames(true));
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, bufferedSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(2U, bufferedSerialMuxProtServer.createChannel("TWO", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)bufferedSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Frames of one batch are packed under a single header.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(2U, testPayload, 2U));
+    TEST_ASSERT_EQUAL_UINT16(superFrameLength, bufferedSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT32(1U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, superFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: A single frame is sent as normal frame.
+     */
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: A full super-frame is closed and a new one is opened.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+
+    for (uint8_t idx = 0U; idx < 6U; idx++)
+    {
+        TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    }
+
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8(SUPER_FRAME_CHANNEL_NUMBER, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(30U, gTestStream.m_outputBuffer[DLC_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], &gTestStream.m_outputBuffer[HEADER_LEN + 30U],
+                                  dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Claimed frames and control frames are not packed.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_NOT_NULL(bufferedSerialMuxProtServer.claim(1U));
+    bufferedSerialMuxProtServer.abort();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Received super-frames are unpacked. Unpacking stops at a malformed record.
+     */
+    testSerialMuxProtServer.subscribeToChannel("TEST", testChannelCallback);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+
+    callbackCounter     = 0U;
+    callbackPayloadSize = 0U;
+    gTestStream.pushToQueue(inputQueueVector[2U], (HEADER_LEN + 18U));
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8(2U, callbackCounter);
+    TEST_ASSERT_EQUAL_UINT8(2U, callbackPayloadSize);
+    TEST_ASSERT_EQUAL_UINT32(0U, testSerialMuxProtServer.getRxStatistics().m_resyncEvents);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test the subscription filter of the TX channels on SerialMuxProt Server.
+ */
+static void testTxSubscriptionFilter()
+{
+    SerialMuxProtServer<2U> testSerialMuxProtServer(gTestStream);
+    const uint8_t           dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    SendStatus              status          = SEND_SENT;
+    uint8_t expectedOutputBufferVector[2U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'},
+        {0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[2U][MAX_FRAME_LEN] = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x53, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 'T', 'E', 'S', 'T'}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(2U, testSerialMuxProtServer.createChannel("TWO", sizeof(testPayload)));
+    testSerialMuxProtServer.enableTxSubscriptionFilter(true);
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Remote not subscribed. Nothing is encoded or written.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isTxChannelSubscribed(1U));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SUPPRESSED, status);
+    TEST_ASSERT_NULL(testSerialMuxProtServer.claim(1U));
+    TEST_ASSERT_EQUAL_UINT32(2U, testSerialMuxProtServer.getTxStatistics().m_suppressedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+
+    /*
+     * Case: Remote subscribed to one channel.
+     */
+    gTestStream.pushToQueue(inputQueueVector[1U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(1U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer,
+                                  controlChannelFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isTxChannelSubscribed(1U));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isTxChannelSubscribed(2U));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.isTxChannelSubscribed(CONTROL_CHANNEL_NUMBER));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SUPPRESSED, status);
+    TEST_ASSERT_EQUAL_UINT32(3U, testSerialMuxProtServer.getTxStatistics().m_suppressedFrames);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+
+    /*
+     * Case: Filter disabled.
+     */
+    testSerialMuxProtServer.enableTxSubscriptionFilter(false);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_EQUAL_UINT8(2U, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test conflated TX channels on SerialMuxProt Server.
+ */
+static void testTxConflation()
+{
+    SerialMuxProtServer<2U>                       testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<2U, 0U, SumChecksum, 64U> bufferedSerialMuxProtServer(gTestStream);
+    const uint8_t                                 dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    const uint8_t                                 newerPayload[4U] = {0x12, 0x34, 0x56, 0x79};
+    uint8_t*                                      payload          = nullptr;
+    uint8_t expectedOutputBufferVector[2U][MAX_FRAME_LEN]          = {
+        {0x01, 0x04, 0x1B, 0x12, 0x34, 0x56, 0x79, 0x02, 0x04, 0x1B, 0x12, 0x34, 0x56, 0x78},
+        {0x02, 0x04, 0x1B, 0x12, 0x34, 0x56, 0x78, 0x01, 0x02, 0x49, 0x12, 0x34}};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Conflation requires the TX staging buffer and a data channel.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.setTxChannelConflation(1U, true));
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.setTxChannelConflation(CONTROL_CHANNEL_NUMBER, true));
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.setTxChannelConflation(3U, true));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.setTxChannelConflation(1U, true));
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, bufferedSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(2U, bufferedSerialMuxProtServer.createChannel("TWO", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)bufferedSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: The queued frame is overwritten in place.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, newerPayload, sizeof(newerPayload)));
+    TEST_ASSERT_EQUAL_UINT16((2U * dataFrameLength), bufferedSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT32(1U, bufferedSerialMuxProtServer.getTxStatistics().m_supersededFrames);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, (2U * dataFrameLength));
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: A queued frame of another length is removed and the new frame is appended.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, 2U));
+    TEST_ASSERT_EQUAL_UINT16((dataFrameLength + HEADER_LEN + 2U), bufferedSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT32(2U, bufferedSerialMuxProtServer.getTxStatistics().m_supersededFrames);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], gTestStream.m_outputBuffer,
+                                  (dataFrameLength + HEADER_LEN + 2U));
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: A committed frame replaces the queued frame.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    payload = bufferedSerialMuxProtServer.claim(1U);
+    TEST_ASSERT_NOT_NULL(payload);
+    memcpy(payload, newerPayload, sizeof(newerPayload));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.commit());
+    TEST_ASSERT_EQUAL_UINT16(dataFrameLength, bufferedSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT32(3U, bufferedSerialMuxProtServer.getTxStatistics().m_supersededFrames);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: A partially written frame is not replaced.
+     */
+    bufferedSerialMuxProtServer.enableTxBackPressure(true);
+    gTestStream.m_availableForWrite = HEADER_LEN;
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.flush());
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, newerPayload, sizeof(newerPayload)));
+    TEST_ASSERT_EQUAL_UINT16((2U * dataFrameLength - HEADER_LEN), bufferedSerialMuxProtServer.getPendingTxBytes());
+    TEST_ASSERT_EQUAL_UINT32(3U, bufferedSerialMuxProtServer.getTxStatistics().m_supersededFrames);
+
+    gTestStream.m_availableForWrite = TEST_STREAM_OUTPUT_BUFFER_SIZE;
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test rate limits of TX channels on SerialMuxProt Server.
+ */
+static void testTxRateLimit()
+{
+    SerialMuxProtServer<2U> testSerialMuxProtServer(gTestStream);
+    const uint8_t           dataFrameLength  = (HEADER_LEN + sizeof(testPayload));
+    const uint8_t           newerPayload[4U] = {0x12, 0x34, 0x56, 0x79};
+    uint8_t                 deferredPayload[sizeof(testPayload)];
+    TxRateLimit             frameRateLimit(RATE_LIMIT_FRAMES, 10U, 2U);
+    TxRateLimit             byteRateLimit(RATE_LIMIT_BYTES, (10U * dataFrameLength), dataFrameLength, RATE_LIMIT_DEFER,
+                                          deferredPayload, sizeof(deferredPayload));
+    SendStatus              status                                = SEND_REJECTED;
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN]          = {{0x02, 0x04, 0x1C, 0x12, 0x34, 0x56, 0x79}};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Invalid channel.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.setTxChannelRateLimit(CONTROL_CHANNEL_NUMBER, &frameRateLimit));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.setTxChannelRateLimit(3U, &frameRateLimit));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.setTxChannelRateLimit(1U, &frameRateLimit));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.setTxChannelRateLimit(2U, &byteRateLimit));
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(2U, testSerialMuxProtServer.createChannel("TWO", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Frames over budget are dropped.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_DROPPED, status);
+    TEST_ASSERT_NULL(testSerialMuxProtServer.claim(1U));
+    TEST_ASSERT_EQUAL_UINT32(1U, frameRateLimit.getDroppedFrames());
+    TEST_ASSERT_EQUAL_UINT32(2U, gTestStream.m_writeCalls);
+
+    /* One frame per 100 ms. */
+    (void)testSerialMuxProtServer.process(99U, 10U, UINT32_MAX);
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    (void)testSerialMuxProtServer.process(100U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(2U, frameRateLimit.getDroppedFrames());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Frames over budget are deferred. The newest deferred frame is sent once the budget allows it.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_SENT, status);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_DEFERRED, status);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(2U, newerPayload, sizeof(newerPayload), status));
+    TEST_ASSERT_EQUAL_UINT8(SEND_DEFERRED, status);
+    TEST_ASSERT_EQUAL_UINT32(2U, byteRateLimit.getDeferredFrames());
+
+    /* The replaced deferred frame is never sent, so it is counted as dropped. */
+    TEST_ASSERT_EQUAL_UINT32(1U, byteRateLimit.getDroppedFrames());
+    gTestStream.flushOutputBuffer();
+
+    (void)testSerialMuxProtServer.process(150U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(0U, gTestStream.m_writeCalls);
+    (void)testSerialMuxProtServer.process(200U, 10U, UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    TEST_ASSERT_FALSE(byteRateLimit.hasDeferredFrame());
+    TEST_ASSERT_EQUAL_UINT32(2U, byteRateLimit.getDeferredFrames());
+    TEST_ASSERT_EQUAL_UINT32(1U, byteRateLimit.getDroppedFrames());
+
+    /*
+     * Case: Rate limit removed.
+     */
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.setTxChannelRateLimit(1U, nullptr));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test priority arbitration of TX channels on SerialMuxProt Server.
+ */
+static void testTxPriority()
+{
+    SerialMuxProtServer<3U>                       testSerialMuxProtServer(gTestStream);
+    SerialMuxProtServer<3U, 0U, SumChecksum, 64U> bufferedSerialMuxProtServer(gTestStream);
+    const uint8_t                                 dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    uint8_t expectedOutputBufferVector[2U][MAX_FRAME_LEN]         = {
+        {0x02, 0x04, 0x1B, 0x12, 0x34, 0x56, 0x78, 0x03, 0x04, 0x1C, 0x12, 0x34, 0x56, 0x78,
+                 0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78},
+        {0x1A, 0x12, 0x34, 0x56, 0x78, 0x02, 0x04, 0x1B, 0x12, 0x34, 0x56, 0x78, 0x01, 0x04, 0x1A, 0x12, 0x34, 0x56,
+                 0x78}};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Invalid configuration.
+     */
+    TEST_ASSERT_FALSE(testSerialMuxProtServer.setTxChannelPriority(1U, TX_PRIORITY_HIGH));
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.setTxChannelPriority(CONTROL_CHANNEL_NUMBER, TX_PRIORITY_HIGH));
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.setTxChannelPriority(4U, TX_PRIORITY_HIGH));
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.setTxChannelPriority(1U, TX_PRIORITY_CONTROL));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.setTxChannelPriority(1U, TX_PRIORITY_LOW));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.setTxChannelPriority(2U, TX_PRIORITY_HIGH));
+
+    /* Sync. */
+    TEST_ASSERT_EQUAL_UINT8(1U, bufferedSerialMuxProtServer.createChannel("BULK", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(2U, bufferedSerialMuxProtServer.createChannel("CMD", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8(3U, bufferedSerialMuxProtServer.createChannel("STATE", sizeof(testPayload)));
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    (void)bufferedSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.isSynced());
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Higher classes are written first, independent of the sending order.
+     */
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(3U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, (3U * dataFrameLength));
+
+    /*
+     * Case: A partially written frame is not overtaken.
+     */
+    bufferedSerialMuxProtServer.enableTxBackPressure(true);
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    gTestStream.m_availableForWrite = 2U;
+    TEST_ASSERT_FALSE(bufferedSerialMuxProtServer.flush());
+
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(2U, testPayload, sizeof(testPayload)));
+    gTestStream.m_availableForWrite = TEST_STREAM_OUTPUT_BUFFER_SIZE;
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[1U], gTestStream.m_outputBuffer,
+                                  ((3U * dataFrameLength) - 2U));
+    bufferedSerialMuxProtServer.enableTxBackPressure(false);
+
+    /*
+     * Case: Control Channel frames are written first. The queueing delay is reported per class.
+     */
+    TEST_ASSERT_EQUAL_UINT32(0U, bufferedSerialMuxProtServer.getTxStatistics().m_maxQueueingDelay[TX_PRIORITY_LOW]);
+    bufferedSerialMuxProtServer.beginBatch();
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    (void)bufferedSerialMuxProtServer.process(HEATBEAT_PERIOD_SYNCED, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(bufferedSerialMuxProtServer.flush());
+    TEST_ASSERT_EQUAL_UINT8(CONTROL_CHANNEL_NUMBER, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT8(1U, gTestStream.m_outputBuffer[controlChannelFrameLength]);
+    TEST_ASSERT_EQUAL_UINT32(HEATBEAT_PERIOD_SYNCED,
+                             bufferedSerialMuxProtServer.getTxStatistics().m_maxQueueingDelay[TX_PRIORITY_LOW]);
+    TEST_ASSERT_EQUAL_UINT32(0U, bufferedSerialMuxProtServer.getTxStatistics().m_maxQueueingDelay[TX_PRIORITY_CONTROL]);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test the lock-free ingest ring as RX source of SerialMuxProt Server.
+ */
+static void testIngestRing()
+{
+    SerialMuxProtServer<2U>      testSerialMuxProtServer(gTestStream);
+    SerialMuxProtIngestRing<64U> ingestRing;
+    const uint8_t                dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    const uint8_t                numberOfFrames  = 200U;
+    std::atomic<bool>            isProducerDone(false);
+    uint8_t                      overflow[70U]   = {0U};
+    uint8_t                      readBuffer[70U] = {0U};
+    uint8_t inputQueueVector[3U][MAX_FRAME_LEN]  = {
+        {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00},
+        {0x00, 0x10, 0x55, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 'T', 'E', 'S', 'T'},
+        {0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Bytes not fitting into the ring are dropped.
+     */
+    TEST_ASSERT_EQUAL_UINT16(64U, ingestRing.push(overflow, sizeof(overflow)));
+    TEST_ASSERT_FALSE(ingestRing.push(0x00));
+    TEST_ASSERT_EQUAL_UINT32(7U, ingestRing.getDroppedBytes());
+    TEST_ASSERT_EQUAL_INT(64, ingestRing.available());
+    TEST_ASSERT_EQUAL_UINT32(64U, ingestRing.readBytes(readBuffer, sizeof(readBuffer)));
+    TEST_ASSERT_EQUAL_INT(0, ingestRing.available());
+
+    /*
+     * Case: Sync and subscribe through the ring. Frames are written to the Stream.
+     */
+    testSerialMuxProtServer.setRxSource(&ingestRing);
+    testSerialMuxProtServer.subscribeToChannel("TEST", testChannelCallback);
+    TEST_ASSERT_EQUAL_UINT16(controlChannelFrameLength,
+                             ingestRing.push(inputQueueVector[0U], controlChannelFrameLength));
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    TEST_ASSERT_EQUAL_UINT8(CONTROL_CHANNEL_NUMBER, gTestStream.m_outputBuffer[CHANNEL_FIELD_IDX]);
+    TEST_ASSERT_EQUAL_UINT16(controlChannelFrameLength,
+                             ingestRing.push(inputQueueVector[1U], controlChannelFrameLength));
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+
+    /*
+     * Case: A producer thread stands in for the interrupt service routine. Chunks wrap around the ring.
+     */
+    callbackCounter = 0U;
+
+    std::thread producer(
+        [&ingestRing, &inputQueueVector, &isProducerDone, dataFrameLength, numberOfFrames]()
+        {
+            for (uint8_t frame = 0U; frame < numberOfFrames; frame++)
+            {
+                uint16_t idx = 0U;
+
+                while (dataFrameLength > idx)
+                {
+                    uint16_t chunkSize = ((frame % 3U) + 1U);
+
+                    if ((dataFrameLength - idx) < chunkSize)
+                    {
+                        chunkSize = (dataFrameLength - idx);
+                    }
+
+                    /* Retry, instead of dropping bytes as an interrupt service routine would. */
+                    if (ingestRing.available() <= static_cast<int>(64U - chunkSize))
+                    {
+                        idx += ingestRing.push(&inputQueueVector[2U][idx], chunkSize);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            isProducerDone = true;
+        });
+
+    /* Consume until the producer is done and the ring is drained. */
+    while ((false == isProducerDone) || (0 < ingestRing.available()))
+    {
+        (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+        std::this_thread::yield();
+    }
+
+    producer.join();
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+
+    TEST_ASSERT_EQUAL_UINT8(numberOfFrames, callbackCounter);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(testPayload), callbackPayloadSize);
+    TEST_ASSERT_EQUAL_UINT32(7U, ingestRing.getDroppedBytes());
+    TEST_ASSERT_EQUAL_UINT32(0U, testSerialMuxProtServer.getRxStatistics().m_discardedBytes);
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+/**
+ * Test the lock-free multi-producer publish queue as TX source of SerialMuxProt Server.
+ */
+static void testPublishQueue()
+{
+    SerialMuxProtServer<2U>          testSerialMuxProtServer(gTestStream);
+    SerialMuxProtPublishQueue<16U>   publishQueue;
+    const uint8_t                    dataFrameLength    = (HEADER_LEN + sizeof(testPayload));
+    const uint8_t                    numberOfProducers  = 4U;
+    const uint8_t                    framesPerProducer  = 100U;
+    uint8_t                          nextSequence[4U]   = {0U};
+    uint16_t                         receivedFrames     = 0U;
+    uint8_t                          channelNumber      = 0U;
+    const uint8_t*                   payload            = nullptr;
+    uint8_t                          payloadSize        = 0U;
+    std::thread                      producers[4U];
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /* Flush Stream */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Invalid payload and full queue.
+     */
+    TEST_ASSERT_FALSE(publishQueue.publish(1U, nullptr, sizeof(testPayload)));
+    TEST_ASSERT_FALSE(publishQueue.publish(1U, testPayload, 0U));
+    TEST_ASSERT_FALSE(publishQueue.publish(1U, testPayload, (MAX_DATA_LEN + 1U)));
+
+    for (uint8_t idx = 0U; idx < 16U; idx++)
+    {
+        TEST_ASSERT_TRUE(publishQueue.publish(1U, testPayload, sizeof(testPayload)));
+    }
+
+    TEST_ASSERT_FALSE(publishQueue.publish(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT32(4U, publishQueue.getRejectedFrames());
+
+    /*
+     * Case: Frames stay queued until synced, and are sent by process().
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    testSerialMuxProtServer.setTxSource(&publishQueue);
+    (void)testSerialMuxProtServer.process(0U);
+    TEST_ASSERT_TRUE(publishQueue.front(channelNumber, payload, payloadSize));
+
+    gTestStream.pushToQueue(inputQueueVector[0U], controlChannelFrameLength);
+    gTestStream.flushOutputBuffer();
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+    TEST_ASSERT_FALSE(publishQueue.front(channelNumber, payload, payloadSize));
+    TEST_ASSERT_EQUAL_UINT32(16U, gTestStream.m_writeCalls);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], gTestStream.m_outputBuffer, dataFrameLength);
+    testSerialMuxProtServer.setTxSource(nullptr);
+
+    /*
+     * Case: Several producer threads publish concurrently. The order of each producer is kept.
+     */
+    for (uint8_t producer = 0U; producer < numberOfProducers; producer++)
+    {
+        producers[producer] = std::thread(
+            [&publishQueue, producer, framesPerProducer]()
+            {
+                for (uint8_t sequence = 0U; sequence < framesPerProducer; sequence++)
+                {
+                    const uint8_t data[2U] = {producer, sequence};
+
+                    while (false == publishQueue.publish((1U + (producer % 2U)), data, sizeof(data)))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    while ((numberOfProducers * framesPerProducer) > receivedFrames)
+    {
+        if (true == publishQueue.front(channelNumber, payload, payloadSize))
+        {
+            TEST_ASSERT_EQUAL_UINT8(2U, payloadSize);
+            TEST_ASSERT_EQUAL_UINT8((1U + (payload[0U] % 2U)), channelNumber);
+            TEST_ASSERT_EQUAL_UINT8(nextSequence[payload[0U]], payload[1U]);
+            nextSequence[payload[0U]]++;
+            receivedFrames++;
+            publishQueue.pop();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (uint8_t producer = 0U; producer < numberOfProducers; producer++)
+    {
+        producers[producer].join();
+    }
+
+    TEST_ASSERT_FALSE(publishQueue.front(channelNumber, payload, payloadSize));
+
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+}
+
+#ifdef TARGET_NATIVE
+
+/**
+ * Read bytes from the peer of a PosixStream, waiting up to one second for them.
+ * @param[in] fd Descriptor of the peer.
+ * @param[in] buffer Array to write bytes to.
+ * @param[in] length Number of bytes to be read.
+ * @returns Number of bytes read.
+ */
+static size_t readFromPeer(int fd, uint8_t* buffer, size_t length)
+{
+    size_t        received   = 0U;
+    struct pollfd pollTarget = {fd, POLLIN, 0};
+
+    while ((length > received) && (0 < poll(&pollTarget, 1U, 1000)))
+    {
+        ssize_t result = read(fd, &buffer[received], (length - received));
+
+        if (0 >= result)
+        {
+            break;
+        }
+
+        received += static_cast<size_t>(result);
+    }
+
+    return received;
+}
+
+/**
+ * Test the Stream over POSIX file descriptors.
+ */
+static void testPosixStream()
+{
+    PosixStream                  stream;
+    PosixStream                  serialStream;
+    SerialMuxProtServer<2U, 64U> testSerialMuxProtServer(stream);
+    const uint8_t                dataFrameLength  = (HEADER_LEN + sizeof(testPayload));
+    uint8_t                      peerBuffer[MAX_FRAME_LEN];
+    int                          peerFds[2U]      = {-1, -1};
+    int                          listenerFd       = -1;
+    int                          peerFd           = -1;
+    struct sockaddr_in           tcpAddress;
+    socklen_t                    tcpAddressLength = sizeof(tcpAddress);
+    IoVector                     vectors[2U];
+    struct pollfd                streamPollTarget = {-1, POLLIN, 0};
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+    uint8_t inputQueueVector[1U][MAX_FRAME_LEN] = {{0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00}};
+
+    /*
+     * Case: Closed Stream.
+     */
+    TEST_ASSERT_FALSE(stream.isOpen());
+    TEST_ASSERT_EQUAL_INT(0, stream.available());
+    TEST_ASSERT_EQUAL_UINT(0U, stream.write(testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT(0U, stream.readBytes(peerBuffer, sizeof(peerBuffer)));
+    TEST_ASSERT_FALSE(stream.openSerial("/dev/null", 12345U));
+    TEST_ASSERT_NULL(stream.getPeerName());
+
+    /*
+     * Case: Attached UNIX-domain socket. Bulk read, vectored write and hang-up.
+     */
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, peerFds));
+    TEST_ASSERT_TRUE(stream.attach(peerFds[0U]));
+    TEST_ASSERT_TRUE(stream.isOpen());
+    TEST_ASSERT_EQUAL_INT(0, stream.available());
+    TEST_ASSERT_EQUAL_UINT(0U, stream.readBytes(peerBuffer, sizeof(peerBuffer)));
+    TEST_ASSERT_TRUE(stream.isOpen());
+    TEST_ASSERT_TRUE(0 < stream.availableForWrite());
+
+    TEST_ASSERT_EQUAL_INT(sizeof(testPayload), write(peerFds[1U], testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_INT(sizeof(testPayload), stream.available());
+    TEST_ASSERT_EQUAL_UINT(sizeof(testPayload), stream.readBytes(peerBuffer, sizeof(peerBuffer)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(testPayload, peerBuffer, sizeof(testPayload));
+
+    vectors[0U].m_data   = expectedOutputBufferVector[0U];
+    vectors[0U].m_length = HEADER_LEN;
+    vectors[1U].m_data   = testPayload;
+    vectors[1U].m_length = sizeof(testPayload);
+    TEST_ASSERT_EQUAL_UINT(dataFrameLength, stream.writev(vectors, 2U));
+    TEST_ASSERT_EQUAL_UINT(dataFrameLength, readFromPeer(peerFds[1U], peerBuffer, dataFrameLength));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], peerBuffer, dataFrameLength);
+
+    (void)close(peerFds[1U]);
+    TEST_ASSERT_EQUAL_UINT(0U, stream.readBytes(peerBuffer, sizeof(peerBuffer)));
+    TEST_ASSERT_FALSE(stream.isOpen());
+    TEST_ASSERT_EQUAL_UINT(0U, stream.write(testPayload, sizeof(testPayload)));
+
+    /*
+     * Case: Server over a pseudo-terminal.
+     */
+    TEST_ASSERT_TRUE(stream.openPseudoTerminal());
+    TEST_ASSERT_NOT_NULL(stream.getPeerName());
+    peerFd = open(stream.getPeerName(), (O_RDWR | O_NOCTTY));
+    TEST_ASSERT_TRUE(0 <= peerFd);
+
+    TEST_ASSERT_EQUAL_UINT8(1U, testSerialMuxProtServer.createChannel("TEST", sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_INT(controlChannelFrameLength, write(peerFd, inputQueueVector[0U], controlChannelFrameLength));
+    streamPollTarget.fd = stream.getFd();
+    TEST_ASSERT_EQUAL_INT(1, poll(&streamPollTarget, 1U, 1000));
+    (void)testSerialMuxProtServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.isSynced());
+
+    TEST_ASSERT_TRUE(testSerialMuxProtServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT(dataFrameLength, readFromPeer(peerFd, peerBuffer, dataFrameLength));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], peerBuffer, dataFrameLength);
+
+    /* The terminal can be opened as serial port, with Mbaud rates, too. */
+    TEST_ASSERT_TRUE(serialStream.openSerial(stream.getPeerName(), 3000000U));
+    serialStream.close();
+    TEST_ASSERT_TRUE(serialStream.openSerial(stream.getPeerName(), 115200U));
+    serialStream.close();
+    (void)close(peerFd);
+    stream.close();
+
+    /*
+     * Case: TCP connection.
+     */
+    memset(&tcpAddress, 0, sizeof(tcpAddress));
+    tcpAddress.sin_family      = AF_INET;
+    tcpAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    tcpAddress.sin_port        = 0U;
+    listenerFd                 = socket(AF_INET, SOCK_STREAM, 0);
+    TEST_ASSERT_TRUE(0 <= listenerFd);
+    TEST_ASSERT_EQUAL_INT(0, bind(listenerFd, reinterpret_cast<struct sockaddr*>(&tcpAddress), sizeof(tcpAddress)));
+    TEST_ASSERT_EQUAL_INT(0, listen(listenerFd, 1));
+    TEST_ASSERT_EQUAL_INT(
+        0, getsockname(listenerFd, reinterpret_cast<struct sockaddr*>(&tcpAddress), &tcpAddressLength));
+
+    TEST_ASSERT_TRUE(stream.connectTcp("127.0.0.1", ntohs(tcpAddress.sin_port)));
+    peerFd = accept(listenerFd, nullptr, nullptr);
+    TEST_ASSERT_TRUE(0 <= peerFd);
+    TEST_ASSERT_EQUAL_UINT(sizeof(testPayload), stream.write(testPayload, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT(sizeof(testPayload), readFromPeer(peerFd, peerBuffer, sizeof(testPayload)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(testPayload, peerBuffer, sizeof(testPayload));
+    (void)close(peerFd);
+    (void)close(listenerFd);
+    stream.close();
+    TEST_ASSERT_FALSE(stream.connectUnix("/nonexistent/serialmuxprot.sock"));
+}
+
+/**
+ * Test the event loop driving several SerialMuxProt Servers.
+ */
+static void testEventLoop()
+{
+    typedef SerialMuxProtServer<2U, 64U> LinkServer;
+
+    SerialMuxProtServer<2U>       deadlineServer(gTestStream);
+    SerialMuxProtPublishQueue<2U> deadlineQueue;
+    PosixStream                   streams[2U];
+    LinkServer                    firstServer(streams[0U]);
+    LinkServer                    secondServer(streams[1U]);
+    SerialMuxProtLink<LinkServer> firstLink(firstServer, streams[0U]);
+    SerialMuxProtLink<LinkServer> secondLink(secondServer, streams[1U]);
+    SerialMuxProtEventLoop<4U>    eventLoop;
+    int                           peerFds[2U][2U] = {{-1, -1}, {-1, -1}};
+    uint8_t                       peerBuffer[MAX_FRAME_LEN];
+    RxDrainResult                 result;
+    const uint8_t                 syncFrame[MAX_FRAME_LEN]         = {0x00, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const uint8_t                 syncResponseFrame[MAX_FRAME_LEN] = {0x00, 0x10, 0x11, 0x01, 0x00, 0x00, 0x00, 0x00};
+
+    /*
+     * Case: Deadlines of a server.
+     */
+    gTestStream.flushInputBuffer();
+    gTestStream.flushOutputBuffer();
+    TEST_ASSERT_EQUAL_UINT32(HEATBEAT_PERIOD_UNSYNCED, deadlineServer.getTimeToNextDeadline(0U));
+    TEST_ASSERT_EQUAL_UINT32((HEATBEAT_PERIOD_UNSYNCED - 400U), deadlineServer.getTimeToNextDeadline(400U));
+    TEST_ASSERT_EQUAL_UINT32(0U, deadlineServer.getTimeToNextDeadline(HEATBEAT_PERIOD_UNSYNCED));
+    TEST_ASSERT_FALSE(deadlineServer.isTxPending());
+
+    /*
+     * Case: A pending TxSource frame is only due while the TX path is not blocked.
+     */
+    TEST_ASSERT_EQUAL_UINT8(1U, deadlineServer.createChannel("TEST", sizeof(testPayload)));
+    deadlineServer.setTxSource(&deadlineQueue);
+    gTestStream.pushToQueue(syncResponseFrame, controlChannelFrameLength);
+    (void)deadlineServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(deadlineServer.isSynced());
+
+    gTestStream.m_writeLimit = 3U;
+    TEST_ASSERT_TRUE(deadlineServer.sendData(1U, testPayload, sizeof(testPayload)));
+    TEST_ASSERT_TRUE(deadlineQueue.publish(1U, testPayload, sizeof(testPayload)));
+    gTestStream.m_writeLimit = 0U;
+    (void)deadlineServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_TRUE(deadlineServer.isTxPending());
+    TEST_ASSERT_NOT_EQUAL(0U, deadlineServer.getTimeToNextDeadline(0U));
+
+    /* A claimed frame blocks the TX path, too. */
+    gTestStream.m_writeLimit = SIZE_MAX;
+    TEST_ASSERT_TRUE(deadlineServer.flush());
+    TEST_ASSERT_FALSE(deadlineServer.isTxPending());
+    TEST_ASSERT_EQUAL_UINT32(0U, deadlineServer.getTimeToNextDeadline(0U));
+    TEST_ASSERT_NOT_NULL(deadlineServer.claim(1U));
+    TEST_ASSERT_NOT_EQUAL(0U, deadlineServer.getTimeToNextDeadline(0U));
+    deadlineServer.abort();
+
+    (void)deadlineServer.process(0U, 10U, UINT32_MAX);
+    TEST_ASSERT_FALSE(deadlineServer.isTxPending());
+    TEST_ASSERT_NOT_EQUAL(0U, deadlineServer.getTimeToNextDeadline(0U));
+    gTestStream.flushOutputBuffer();
+
+    /*
+     * Case: Register links.
+     */
+    TEST_ASSERT_TRUE(eventLoop.isValid());
+    TEST_ASSERT_FALSE(eventLoop.addLink(nullptr));
+    TEST_ASSERT_FALSE(eventLoop.addLink(&firstLink));
+
+    for (uint8_t idx = 0U; idx < 2U; idx++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, peerFds[idx]));
+        TEST_ASSERT_TRUE(streams[idx].attach(peerFds[idx][0U]));
+    }
+
+    TEST_ASSERT_TRUE(eventLoop.addLink(&firstLink));
+    TEST_ASSERT_TRUE(eventLoop.addLink(&secondLink));
+    TEST_ASSERT_FALSE(eventLoop.addLink(&firstLink));
+    TEST_ASSERT_EQUAL_UINT8(2U, eventLoop.getNumberOfLinks());
+
+    /*
+     * Case: Heartbeats are due.
+     */
+    TEST_ASSERT_EQUAL_UINT8(2U, eventLoop.runOnce(0U));
+    TEST_ASSERT_EQUAL_UINT(controlChannelFrameLength,
+                           readFromPeer(peerFds[0U][1U], peerBuffer, controlChannelFrameLength));
+    TEST_ASSERT_EQUAL_UINT8(COMMANDS::SYNC, peerBuffer[HEADER_LEN]);
+
+    /*
+     * Case: Only the readable link is processed.
+     */
+    makeSyncResponse(peerBuffer);
+    TEST_ASSERT_EQUAL_INT(controlChannelFrameLength, write(peerFds[0U][1U], peerBuffer, controlChannelFrameLength));
+    TEST_ASSERT_EQUAL_UINT8(1U, eventLoop.runOnce(1000U));
+    TEST_ASSERT_TRUE(firstServer.isSynced());
+    TEST_ASSERT_FALSE(secondServer.isSynced());
+    TEST_ASSERT_TRUE(HEATBEAT_PERIOD_UNSYNCED < firstLink.getTimeToNextDeadline(eventLoop.getTimestamp()));
+
+    /*
+     * Case: Idle links and wake-up.
+     */
+    TEST_ASSERT_EQUAL_UINT8(0U, eventLoop.runOnce(10U));
+    eventLoop.wakeUp();
+    TEST_ASSERT_EQUAL_UINT8(0U, eventLoop.runOnce(1000U));
+
+    /*
+     * Case: Hung-up link is unregistered.
+     */
+    (void)close(peerFds[1U][1U]);
+    TEST_ASSERT_EQUAL_UINT8(1U, eventLoop.runOnce(1000U));
+    TEST_ASSERT_FALSE(secondLink.isOpen());
+    TEST_ASSERT_EQUAL_UINT8(1U, eventLoop.getNumberOfLinks());
+
+    /*
+     * Case: A frame left in the RX buffer is not dispatched on a wake-up without readable event.
+     */
+    TEST_ASSERT_EQUAL_INT(controlChannelFrameLength, write(peerFds[0U][1U], syncFrame, controlChannelFrameLength));
+    TEST_ASSERT_EQUAL_INT(controlChannelFrameLength, write(peerFds[0U][1U], syncFrame, controlChannelFrameLength));
+    TEST_ASSERT_EQUAL_UINT16(1U, firstServer.process(1000U, 1U, UINT32_MAX).m_dispatchedFrames);
+    firstLink.process(1000U, false);
+    result = firstServer.process(1000U, 0U, 0U);
+    TEST_ASSERT_EQUAL_UINT16(0U, result.m_dispatchedFrames);
+    TEST_ASSERT_EQUAL_UINT32(controlChannelFrameLength, result.m_pendingBytes);
+    TEST_ASSERT_EQUAL_UINT16(1U, firstServer.process(1000U, 10U, UINT32_MAX).m_dispatchedFrames);
+
+    TEST_ASSERT_TRUE(eventLoop.removeLink(&firstLink));
+    TEST_ASSERT_FALSE(eventLoop.removeLink(&firstLink));
+    TEST_ASSERT_EQUAL_UINT8(0U, eventLoop.getNumberOfLinks());
+    (void)close(peerFds[0U][1U]);
+}
+
+/**
+ * Turn a received SYNC frame into the matching SYNC_RSP frame.
+ * @param[in,out] frame SYNC frame, replaced by the SYNC_RSP frame.
+ */
+static void makeSyncResponse(uint8_t* frame)
+{
+    uint32_t checksum = 0U;
+
+    frame[HEADER_LEN] = COMMANDS::SYNC_RSP;
+    checksum          = frame[0U] + frame[1U];
+
+    for (uint8_t idx = HEADER_LEN; idx < controlChannelFrameLength; idx++)
+    {
+        checksum += frame[idx];
+    }
+
+    frame[2U] = static_cast<uint8_t>(checksum % UINT8_MAX);
+}
+
+/**
+ * Test the runtime sharding SerialMuxProt Servers across worker threads.
+ */
+static void testRuntime()
+{
+    typedef SerialMuxProtServer<2U, 64U> LinkServer;
+
+    SerialMuxProtRuntime<2U, 4U>  runtime;
+    PosixStream                   streams[3U];
+    LinkServer                    firstServer(streams[0U]);
+    LinkServer                    secondServer(streams[1U]);
+    LinkServer                    thirdServer(streams[2U]);
+    SerialMuxProtLink<LinkServer> firstLink(firstServer, streams[0U]);
+    SerialMuxProtLink<LinkServer> secondLink(secondServer, streams[1U]);
+    SerialMuxProtLink<LinkServer> thirdLink(thirdServer, streams[2U]);
+    SerialMuxProtPublishQueue<4U> forwardQueue;
+    const uint8_t                 dataFrameLength = (HEADER_LEN + sizeof(testPayload));
+    int                           peerFds[3U][2U] = {{-1, -1}, {-1, -1}, {-1, -1}};
+    uint8_t                       peerBuffer[MAX_FRAME_LEN];
+    SerialMuxProtRuntime<2U, 4U>  balancedRuntime;
+    TestLoadLink                  firstBusyLink(1000U);
+    TestLoadLink                  secondBusyLink(1000U);
+    TestLoadLink                  idleLink(0U);
+    uint32_t                      loads[2U]       = {0U, 0U};
+    uint8_t expectedOutputBufferVector[1U][MAX_FRAME_LEN] = {{0x01, 0x04, 0x1A, 0x12, 0x34, 0x56, 0x78}};
+
+    for (uint8_t idx = 0U; idx < 3U; idx++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, peerFds[idx]));
+        TEST_ASSERT_TRUE(streams[idx].attach(peerFds[idx][0U]));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(1U, thirdServer.createChannel("TEST", sizeof(testPayload)));
+    thirdServer.setTxSource(&forwardQueue);
+
+    /*
+     * Case: Placement of links.
+     */
+    TEST_ASSERT_FALSE(runtime.addLink(nullptr));
+    TEST_ASSERT_TRUE(runtime.addLink(&firstLink));
+    TEST_ASSERT_TRUE(runtime.addLink(&secondLink));
+    TEST_ASSERT_TRUE(runtime.addLink(&thirdLink));
+    TEST_ASSERT_FALSE(runtime.addLink(&firstLink));
+    TEST_ASSERT_EQUAL_UINT8(0U, runtime.getWorker(&firstLink));
+    TEST_ASSERT_EQUAL_UINT8(1U, runtime.getWorker(&secondLink));
+    TEST_ASSERT_EQUAL_UINT8(0U, runtime.getWorker(&thirdLink));
+    TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, runtime.getWorker(nullptr));
+    TEST_ASSERT_EQUAL_UINT8(2U, runtime.getNumberOfLinks(0U));
+    TEST_ASSERT_EQUAL_UINT8(1U, runtime.getNumberOfLinks(1U));
+
+    /*
+     * Case: Workers send the heartbeats of their links.
+     */
+    TEST_ASSERT_TRUE(runtime.start());
+    TEST_ASSERT_FALSE(runtime.start());
+
+    for (uint8_t idx = 0U; idx < 3U; idx++)
+    {
+        TEST_ASSERT_EQUAL_UINT(controlChannelFrameLength,
+                               readFromPeer(peerFds[idx][1U], peerBuffer, controlChannelFrameLength));
+        TEST_ASSERT_EQUAL_UINT8(COMMANDS::SYNC, peerBuffer[HEADER_LEN]);
+    }
+
+    /*
+     * Case: Frames forwarded from another thread are sent by the worker owning the link.
+     */
+    TEST_ASSERT_TRUE(forwardQueue.publish(1U, testPayload, sizeof(testPayload)));
+    makeSyncResponse(peerBuffer);
+    TEST_ASSERT_EQUAL_INT(controlChannelFrameLength, write(peerFds[2U][1U], peerBuffer, controlChannelFrameLength));
+    TEST_ASSERT_EQUAL_UINT(dataFrameLength, readFromPeer(peerFds[2U][1U], peerBuffer, dataFrameLength));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], peerBuffer, dataFrameLength);
+
+    TEST_ASSERT_TRUE(forwardQueue.publish(1U, testPayload, sizeof(testPayload)));
+    runtime.notify(&thirdLink);
+    TEST_ASSERT_EQUAL_UINT(dataFrameLength, readFromPeer(peerFds[2U][1U], peerBuffer, dataFrameLength));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], peerBuffer, dataFrameLength);
+
+    /*
+     * Case: Link moved to another worker.
+     */
+    TEST_ASSERT_FALSE(runtime.moveLink(&thirdLink, 2U));
+    TEST_ASSERT_TRUE(runtime.moveLink(&thirdLink, 1U));
+
+    for (uint16_t retries = 0U; (2000U > retries) && (1U != runtime.getWorker(&thirdLink)); retries++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(1U, runtime.getWorker(&thirdLink));
+    TEST_ASSERT_EQUAL_UINT32(1U, runtime.getMigrations());
+
+    TEST_ASSERT_TRUE(forwardQueue.publish(1U, testPayload, sizeof(testPayload)));
+    runtime.notify(&thirdLink);
+    TEST_ASSERT_EQUAL_UINT(dataFrameLength, readFromPeer(peerFds[2U][1U], peerBuffer, dataFrameLength));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedOutputBufferVector[0U], peerBuffer, dataFrameLength);
+
+    /*
+     * Case: Hung-up link is released, others are removed.
+     */
+    (void)close(peerFds[1U][1U]);
+
+    for (uint16_t retries = 0U; (2000U > retries) && (UINT8_MAX != runtime.getWorker(&secondLink)); retries++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, runtime.getWorker(&secondLink));
+    TEST_ASSERT_TRUE(runtime.removeLink(&firstLink));
+    TEST_ASSERT_FALSE(runtime.removeLink(&firstLink));
+    TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, runtime.getWorker(&firstLink));
+
+    runtime.stop();
+    TEST_ASSERT_TRUE(runtime.removeLink(&thirdLink));
+    TEST_ASSERT_EQUAL_UINT8(0U, runtime.getNumberOfLinks(0U));
+    TEST_ASSERT_EQUAL_UINT8(0U, runtime.getNumberOfLinks(1U));
+
+    (void)close(peerFds[0U][1U]);
+    (void)close(peerFds[2U][1U]);
+
+    /*
+     * Case: Busy links placed on one worker are spread by rebalancing, and the loads converge.
+     */
+    TEST_ASSERT_TRUE(balancedRuntime.addLink(&firstBusyLink));
+    TEST_ASSERT_TRUE(balancedRuntime.addLink(&idleLink));
+    TEST_ASSERT_TRUE(balancedRuntime.addLink(&secondBusyLink));
+    TEST_ASSERT_EQUAL_UINT8(0U, balancedRuntime.getWorker(&firstBusyLink));
+    TEST_ASSERT_EQUAL_UINT8(1U, balancedRuntime.getWorker(&idleLink));
+    TEST_ASSERT_EQUAL_UINT8(0U, balancedRuntime.getWorker(&secondBusyLink));
+    TEST_ASSERT_TRUE(balancedRuntime.start());
+
+    for (uint16_t retries = 0U;
+         (5000U > retries) && (balancedRuntime.getWorker(&firstBusyLink) == balancedRuntime.getWorker(&secondBusyLink));
+         retries++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    TEST_ASSERT_TRUE(balancedRuntime.getWorker(&firstBusyLink) != balancedRuntime.getWorker(&secondBusyLink));
+    TEST_ASSERT_TRUE(0U < balancedRuntime.getMigrations());
+
+    /* Wait until both workers have measured a full period after the migration. */
+    std::this_thread::sleep_for(std::chrono::milliseconds(3U * RUNTIME_REBALANCE_PERIOD));
+    loads[0U] = balancedRuntime.getLoad(0U);
+    loads[1U] = balancedRuntime.getLoad(1U);
+    TEST_ASSERT_TRUE(RUNTIME_REBALANCE_MIN_LOAD < loads[0U]);
+    TEST_ASSERT_TRUE(RUNTIME_REBALANCE_MIN_LOAD < loads[1U]);
+    TEST_ASSERT_TRUE((loads[0U] / 2U) < loads[1U]);
+    TEST_ASSERT_TRUE((loads[1U] / 2U) < loads[0U]);
+
+    TEST_ASSERT_TRUE(balancedRuntime.removeLink(&firstBusyLink));
+    TEST_ASSERT_TRUE(balancedRuntime.removeLink(&secondBusyLink));
+    TEST_ASSERT_TRUE(balancedRuntime.removeLink(&idleLink));
+    balancedRuntime.stop();
+}
+
+#endif /* TARGET_NATIVE */